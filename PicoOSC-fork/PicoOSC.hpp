@@ -1,12 +1,83 @@
 #pragma once
 
+#include <atomic>
 #include <climits>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
-
+#include <limits>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#if defined(LIB_PICO_TIME)
+#include "pico/time.h"
+#else
+#include <chrono>
+#endif
+
+// Set to 1 to record hot-path trace events (see OSCTracer)
+#ifndef PICOOSC_TRACE
+#define PICOOSC_TRACE 0
+#endif
+
+#if PICOOSC_TRACE
+#include <cstdio>
+#if defined(LIB_PICO_TIME)
+#include "hardware/sync.h"
+#endif
+#endif
+
+#include "lwip/igmp.h"
 #include "lwip/pbuf.h"
+#include "lwip/tcp.h"
 #include "lwip/udp.h"
 
+// Logging
+//
+// Compiled out unless PICOOSC_LOG_LEVEL is defined before including this
+// header: 0 = off (default), 1 = errors, 2 = warnings, 3 = info.
+// Messages go to PICOOSC_LOG_HANDLER(level, format, ...), which defaults to
+// printf; define it to route them elsewhere. include/PicoOSC/PicoOSCLog.hpp
+// defines the same macros behind the same guards.
+#ifndef PICOOSC_LOG_LEVEL
+#define PICOOSC_LOG_LEVEL 0
+#endif
+
+#ifndef PICOOSC_LOG_HANDLER
+#include <cstdio>
+#define PICOOSC_LOG_HANDLER(level, ...) std::printf(__VA_ARGS__)
+#endif
+
+#ifndef PICOOSC_LOG_ERROR
+#if PICOOSC_LOG_LEVEL >= 1
+#define PICOOSC_LOG_ERROR(...) PICOOSC_LOG_HANDLER(1, __VA_ARGS__)
+#else
+#define PICOOSC_LOG_ERROR(...) ((void)0)
+#endif
+
+#if PICOOSC_LOG_LEVEL >= 2
+#define PICOOSC_LOG_WARN(...) PICOOSC_LOG_HANDLER(2, __VA_ARGS__)
+#else
+#define PICOOSC_LOG_WARN(...) ((void)0)
+#endif
+
+#if PICOOSC_LOG_LEVEL >= 3
+#define PICOOSC_LOG_INFO(...) PICOOSC_LOG_HANDLER(3, __VA_ARGS__)
+#else
+#define PICOOSC_LOG_INFO(...) ((void)0)
+#endif
+#endif
+
 namespace picoosc
 {
 
@@ -15,6 +86,57 @@ static constexpr std::size_t MAX_MESSAGE_SIZE = 1024;
 static constexpr std::size_t MAX_ADDRESS_SIZE = 256;
 static constexpr std::size_t MAX_TYPE_TAG_SIZE = 64;
 static constexpr std::size_t MAX_ARG_BUFFER_SIZE = 768;
+static constexpr std::size_t MAX_MULTICAST_GROUPS = 4;
+static constexpr std::size_t MAX_GROUP_DESTINATIONS = 32;
+static constexpr std::size_t PBUF_POOL_SLOTS = 4;
+static constexpr std::size_t MAX_STREAM_PACKET_SIZE = 4096;
+static constexpr std::size_t MAX_TCP_CONNECTIONS = 2;
+static constexpr std::size_t LATENCY_BUCKETS = 16;
+static constexpr std::size_t MAX_BUNDLE_DEPTH = 8;  // Nested bundles; deeper ones are dropped
+
+static constexpr std::size_t MAX_ROUTES = 16;    // Typed handlers per dispatcher
+static constexpr std::size_t MAX_HANDLERS = 16;  // Message handlers per dispatcher
+static constexpr std::size_t HANDLER_STORAGE_SIZE = 4 * sizeof(void*);  // Inline closure capture
+static constexpr std::size_t MAX_ALIASES = 32;
+static constexpr std::size_t MAX_ALIAS_ADDRESS_SIZE = 64;
+static constexpr std::size_t COALESCE_SLOTS = 16;  // Power of two
+static constexpr std::size_t COALESCE_SLOT_SIZE = 128;
+static constexpr std::size_t SYNC_MTU = MAX_MESSAGE_SIZE;  // Largest state sync bundle; keep <= the receive buffer
+static constexpr std::size_t TRACE_BUFFER_SIZE = 256;  // Records per core, power of two
+static constexpr std::size_t TRACE_CORES = 2;
+static constexpr std::size_t CLOCK_SAMPLES = 8;  // Round trips kept by OSCClockSync's filter
+
+// Set to 0 to compile all statistics counters (and their storage) away
+#ifndef PICOOSC_STATS
+#define PICOOSC_STATS 1
+#endif
+
+// Set to 1 to time every send and handler call into the latency
+// histograms (two clock reads each); needs PICOOSC_STATS
+#ifndef PICOOSC_LATENCY_STATS
+#define PICOOSC_LATENCY_STATS 0
+#endif
+
+/**
+ * High 64 bits of a 64x64-bit product, from 32-bit halves
+ * (there is no 128-bit type on the Cortex-M0+)
+ */
+constexpr uint64_t mulHigh64(uint64_t a, uint64_t b)
+{
+    const uint64_t aLo = a & 0xFFFFFFFFu;
+    const uint64_t aHi = a >> 32;
+    const uint64_t bLo = b & 0xFFFFFFFFu;
+    const uint64_t bHi = b >> 32;
+    const uint64_t hiLo = aHi * bLo;
+    const uint64_t cross = ((aLo * bLo) >> 32) + (hiLo & 0xFFFFFFFFu) + aLo * bHi;  // Cannot overflow
+    return aHi * bHi + (hiLo >> 32) + (cross >> 32);
+}
+
+// Exact x / 15625 for any x, and x / 1953125 for x < 2^55, as a multiply
+// by a rounded-up reciprocal: the M0+ has no divider and a 64-bit division
+// is a slow library call. 10^6 = 2^6 * 15625 and 10^9 = 2^9 * 1953125.
+constexpr uint64_t divide15625(uint64_t x) { return mulHigh64(x, 0x431BDE82D7B634DBull) >> 12; }
+constexpr uint64_t divide1953125(uint64_t x) { return mulHigh64(x, 0x44B82FA09B5A53ull) >> 11; }
 
 // OSC Timetag representing NTP timestamp
 struct OSCTimetag
@@ -22,7 +144,83 @@ struct OSCTimetag
     uint32_t seconds;      // Seconds since Jan 1, 1900
     uint32_t fractions;    // Fractional seconds
 
-    static OSCTimetag immediate() { return {1, 0}; }
+    static constexpr uint64_t UNIX_EPOCH_SECONDS = 2208988800u;  // 1970 in NTP time
+
+    static constexpr OSCTimetag immediate() { return {0, 1}; }  // The special value 1 (OSC 1.0)
+
+    constexpr bool isImmediate() const { return seconds == 0 && fractions == 1; }
+
+    /**
+     * 32.32 fixed-point value, for ordering
+     */
+    constexpr uint64_t raw() const { return (static_cast<uint64_t>(seconds) << 32) | fractions; }
+
+    static constexpr OSCTimetag fromRaw(uint64_t raw)
+    {
+        return {static_cast<uint32_t>(raw >> 32), static_cast<uint32_t>(raw)};
+    }
+
+    /**
+     * Duration conversions between microseconds or nanoseconds and 32.32
+     * NTP units, rounded to nearest. No 64-bit division: seconds are split
+     * off with a reciprocal multiply and the fraction is scaled in 64 bits.
+     */
+    static constexpr uint64_t ntpFromMicros(uint64_t micros)
+    {
+        const uint64_t secs = divide15625(micros >> 6);
+        const uint64_t rest = micros - secs * 1000000;                // < 10^6
+        return (secs << 32) + divide15625((rest << 26) + 15625 / 2);  // rest * 2^32 / 10^6
+    }
+
+    static constexpr uint64_t microsFromNtp(uint64_t ntp)
+    {
+        return (ntp >> 32) * 1000000 + (((ntp & 0xFFFFFFFFu) * 1000000 + 0x80000000u) >> 32);
+    }
+
+    static constexpr uint64_t ntpFromNanos(uint64_t nanos)
+    {
+        const uint64_t secs = divide1953125(nanos >> 9);
+        const uint64_t rest = nanos - secs * 1000000000;                    // < 10^9
+        return (secs << 32) + divide1953125((rest << 23) + 1953125 / 2);  // rest * 2^32 / 10^9
+    }
+
+    static constexpr uint64_t nanosFromNtp(uint64_t ntp)
+    {
+        return (ntp >> 32) * 1000000000 + (((ntp & 0xFFFFFFFFu) * 1000000000 + 0x80000000u) >> 32);
+    }
+
+    static constexpr OSCTimetag fromUnixMicros(uint64_t unixMicros)
+    {
+        return fromRaw((UNIX_EPOCH_SECONDS << 32) + ntpFromMicros(unixMicros));
+    }
+
+    constexpr uint64_t toUnixMicros() const { return microsFromNtp(raw() - (UNIX_EPOCH_SECONDS << 32)); }
+
+    /**
+     * This time moved by a signed number of microseconds
+     */
+    constexpr OSCTimetag addMicros(int64_t micros) const
+    {
+        return fromRaw(micros >= 0 ? raw() + ntpFromMicros(static_cast<uint64_t>(micros))
+                                   : raw() - ntpFromMicros(0 - static_cast<uint64_t>(micros)));
+    }
+
+    /**
+     * Signed microseconds from earlier to this time
+     */
+    constexpr int64_t microsSince(OSCTimetag earlier) const
+    {
+        const uint64_t delta = raw() - earlier.raw();
+        return static_cast<int64_t>(delta) >= 0 ? static_cast<int64_t>(microsFromNtp(delta))
+                                                : -static_cast<int64_t>(microsFromNtp(0 - delta));
+    }
+
+    friend constexpr bool operator==(OSCTimetag a, OSCTimetag b) { return a.raw() == b.raw(); }
+    friend constexpr bool operator!=(OSCTimetag a, OSCTimetag b) { return a.raw() != b.raw(); }
+    friend constexpr bool operator<(OSCTimetag a, OSCTimetag b) { return a.raw() < b.raw(); }
+    friend constexpr bool operator<=(OSCTimetag a, OSCTimetag b) { return a.raw() <= b.raw(); }
+    friend constexpr bool operator>(OSCTimetag a, OSCTimetag b) { return a.raw() > b.raw(); }
+    friend constexpr bool operator>=(OSCTimetag a, OSCTimetag b) { return a.raw() >= b.raw(); }
 };
 
 // Swap endianness for network byte order (big-endian)
@@ -80,6 +278,512 @@ inline double swap_endian_double(double value)
     return value;
 }
 
+// Monotonic microsecond clock (time_us_32() on the Pico)
+inline uint32_t monotonicMicros()
+{
+#if defined(LIB_PICO_TIME)
+    return time_us_32();
+#else
+    using namespace std::chrono;
+    return static_cast<uint32_t>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// 64-bit variant for clocks that must not wrap (time_us_64() on the Pico)
+inline uint64_t monotonicMicros64()
+{
+#if defined(LIB_PICO_TIME)
+    return time_us_64();
+#else
+    using namespace std::chrono;
+    return static_cast<uint64_t>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * Reasons OSCMessageView::parse() or bundle unpacking can fail
+ */
+enum class OSCParseError : uint8_t
+{
+    None,
+    InvalidAddress,        // Too short or not starting with '/'
+    UnterminatedAddress,
+    UnterminatedTypeTags,
+    TruncatedArgument,     // Fixed-size argument runs past the end
+    UnterminatedString,
+    InvalidBlobSize,
+    InvalidBundleElement,  // Bundle element size out of range
+    UnknownAlias,          // Integer address not in the alias table
+    InvalidPadding,        // Non-zero byte after a string terminator
+    UnknownTypeTag,        // Strict mode only
+    TooManyArguments,      // More than MAX_ARGS (strict mode only)
+    TrailingData,          // Bytes after the last argument (strict mode only)
+    BundleTooDeep,         // More than MAX_BUNDLE_DEPTH nested bundles
+    TimetagOrder,          // Nested bundle earlier than its parent (strict mode only)
+    Count,
+};
+
+static constexpr std::size_t PARSE_ERROR_COUNT = static_cast<std::size_t>(OSCParseError::Count);
+
+/**
+ * Statistics counter with a single writer (the lwIP context)
+ *
+ * Updates are a relaxed load + store rather than a read-modify-write, so
+ * they are lock-free even on the M0+, and readers on the other core always
+ * see whole values. With PICOOSC_STATS 0 it has no storage and reads as 0.
+ */
+#if PICOOSC_STATS
+class OSCCounter
+{
+public:
+    void add(uint32_t n = 1)
+    {
+        mValue.store(mValue.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void updateMax(uint32_t value)
+    {
+        if (value > mValue.load(std::memory_order_relaxed)) {
+            mValue.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t value() const { return mValue.load(std::memory_order_relaxed); }
+    void reset() { mValue.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> mValue{0};
+};
+#else
+class OSCCounter
+{
+public:
+    void add(uint32_t = 1) {}
+    void updateMax(uint32_t) {}
+    uint32_t value() const { return 0; }
+    void reset() {}
+};
+#endif
+
+/**
+ * Latency histogram with log2 microsecond buckets
+ * Bucket 0 counts < 1 us, bucket n counts [2^(n-1), 2^n) us, and the last
+ * bucket everything above. Without PICOOSC_LATENCY_STATS it has no
+ * storage and reads as all zeros.
+ */
+#if PICOOSC_STATS && PICOOSC_LATENCY_STATS
+class OSCLatencyHistogram
+{
+public:
+    void record(uint32_t micros)
+    {
+        std::size_t bucket = 0;
+        while (micros != 0 && bucket < LATENCY_BUCKETS - 1) {
+            micros >>= 1;
+            bucket++;
+        }
+        mBuckets[bucket].add();
+    }
+
+    void snapshot(uint32_t (&out)[LATENCY_BUCKETS]) const
+    {
+        for (std::size_t i = 0; i < LATENCY_BUCKETS; i++) out[i] = mBuckets[i].value();
+    }
+
+    void reset()
+    {
+        for (OSCCounter& bucket : mBuckets) bucket.reset();
+    }
+
+private:
+    OSCCounter mBuckets[LATENCY_BUCKETS];
+};
+#else
+class OSCLatencyHistogram
+{
+public:
+    void record(uint32_t) {}
+
+    void snapshot(uint32_t (&out)[LATENCY_BUCKETS]) const
+    {
+        for (uint32_t& bucket : out) bucket = 0;
+    }
+
+    void reset() {}
+};
+#endif
+
+/**
+ * Snapshot of a sender's counters
+ */
+struct OSCClientStats
+{
+    uint32_t packetsOut = 0;
+    uint32_t bytesOut = 0;
+    uint32_t sendErrors = 0;         // Transport rejected the packet
+    uint32_t pbufAllocFailures = 0;  // No pbuf available at all
+    uint32_t poolFallbacks = 0;      // Pool empty, sent from the heap instead
+    uint32_t sendLatency[LATENCY_BUCKETS] = {};
+};
+
+/**
+ * Live counters behind OSCClientStats
+ */
+struct OSCClientCounters
+{
+    OSCCounter packetsOut;
+    OSCCounter bytesOut;
+    OSCCounter sendErrors;
+    OSCCounter pbufAllocFailures;
+    OSCCounter poolFallbacks;
+    OSCLatencyHistogram sendLatency;
+
+    OSCClientStats snapshot() const
+    {
+        OSCClientStats stats;
+        stats.packetsOut = packetsOut.value();
+        stats.bytesOut = bytesOut.value();
+        stats.sendErrors = sendErrors.value();
+        stats.pbufAllocFailures = pbufAllocFailures.value();
+        stats.poolFallbacks = poolFallbacks.value();
+        sendLatency.snapshot(stats.sendLatency);
+        return stats;
+    }
+
+    void reset()
+    {
+        packetsOut.reset();
+        bytesOut.reset();
+        sendErrors.reset();
+        pbufAllocFailures.reset();
+        poolFallbacks.reset();
+        sendLatency.reset();
+    }
+};
+
+/**
+ * Snapshot of a receiver's counters
+ */
+struct OSCServerStats
+{
+    uint32_t packetsIn = 0;
+    uint32_t bytesIn = 0;
+    uint32_t truncatedPackets = 0;    // Larger than the receive buffer
+    uint32_t bundlesIn = 0;
+    uint32_t maxBundleDepth = 0;
+    uint32_t messagesDispatched = 0;
+    uint32_t dispatchMisses = 0;      // Valid message but nothing to handle it
+    uint32_t coalescedMessages = 0;   // Replaced by a newer value before dispatch
+    uint32_t clampedTimetags = 0;     // Nested bundle timetag raised to its parent's
+    uint32_t parseErrors[PARSE_ERROR_COUNT] = {};
+    uint32_t handlerLatency[LATENCY_BUCKETS] = {};
+
+    uint32_t parseError(OSCParseError reason) const
+    {
+        return parseErrors[static_cast<std::size_t>(reason)];
+    }
+
+    uint32_t totalParseErrors() const
+    {
+        uint32_t total = 0;
+        for (uint32_t count : parseErrors) total += count;
+        return total;
+    }
+};
+
+/**
+ * Live counters behind OSCServerStats
+ */
+struct OSCServerCounters
+{
+    OSCCounter packetsIn;
+    OSCCounter bytesIn;
+    OSCCounter truncatedPackets;
+    OSCCounter bundlesIn;
+    OSCCounter maxBundleDepth;
+    OSCCounter messagesDispatched;
+    OSCCounter dispatchMisses;
+    OSCCounter coalescedMessages;
+    OSCCounter clampedTimetags;
+    OSCCounter parseErrors[PARSE_ERROR_COUNT];
+    OSCLatencyHistogram handlerLatency;
+
+    void parseError(OSCParseError reason) { parseErrors[static_cast<std::size_t>(reason)].add(); }
+
+    OSCServerStats snapshot() const
+    {
+        OSCServerStats stats;
+        stats.packetsIn = packetsIn.value();
+        stats.bytesIn = bytesIn.value();
+        stats.truncatedPackets = truncatedPackets.value();
+        stats.bundlesIn = bundlesIn.value();
+        stats.maxBundleDepth = maxBundleDepth.value();
+        stats.messagesDispatched = messagesDispatched.value();
+        stats.dispatchMisses = dispatchMisses.value();
+        stats.coalescedMessages = coalescedMessages.value();
+        stats.clampedTimetags = clampedTimetags.value();
+        for (std::size_t i = 0; i < PARSE_ERROR_COUNT; i++) {
+            stats.parseErrors[i] = parseErrors[i].value();
+        }
+        handlerLatency.snapshot(stats.handlerLatency);
+        return stats;
+    }
+
+    void reset()
+    {
+        packetsIn.reset();
+        bytesIn.reset();
+        truncatedPackets.reset();
+        bundlesIn.reset();
+        maxBundleDepth.reset();
+        messagesDispatched.reset();
+        dispatchMisses.reset();
+        coalescedMessages.reset();
+        clampedTimetags.reset();
+        for (OSCCounter& counter : parseErrors) counter.reset();
+        handlerLatency.reset();
+    }
+};
+
+/**
+ * Stages recorded by the tracer
+ */
+enum class OSCTraceEvent : uint8_t
+{
+    Receive,   // Transport receive callback
+    Parse,     // OSCMessageView::parse
+    Dispatch,  // Packet/bundle dispatch
+    Handler,   // User callback
+    Send,      // Client send
+    Count,
+};
+
+#if PICOOSC_TRACE
+/**
+ * Flight recorder for hot-path trace events
+ *
+ * Every stage records a begin and an end event (event, timestamp, size)
+ * into a ring per core, overwriting the oldest records. Each ring has a
+ * single writer, so recording is lock-free. Timestamps are 32-bit
+ * microseconds from monotonicMicros() (time_us_32() on the Pico) and are
+ * unwrapped when dumped, which is exact as long as no two consecutive
+ * records on a core are more than 2^32 us (about 71 minutes) apart.
+ *
+ * Enable with PICOOSC_TRACE=1. dumpChromeTrace() writes the recorded
+ * events as Chrome trace JSON (chrome://tracing, Perfetto). Dump while the
+ * stack is quiet; records written during the dump may be torn.
+ */
+class OSCTracer
+{
+public:
+    struct Record
+    {
+        uint32_t timestamp;
+        uint16_t size;
+        OSCTraceEvent event;
+        char phase;  // 'B' begin, 'E' end
+    };
+
+    static OSCTracer& instance()
+    {
+        static OSCTracer tracer;
+        return tracer;
+    }
+
+    static uint32_t now() { return monotonicMicros(); }
+
+    void record(OSCTraceEvent event, char phase, std::size_t size)
+    {
+        Ring& ring = mRings[currentCore()];
+        const std::size_t head = ring.head.load(std::memory_order_relaxed);
+        ring.records[head & (TRACE_BUFFER_SIZE - 1)] = {
+            now(), static_cast<uint16_t>(size > 0xFFFF ? 0xFFFF : size), event, phase};
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    void clear()
+    {
+        for (Ring& ring : mRings) ring.head.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Write all recorded events as Chrome trace JSON
+     * @param write Called as write(const char* data, std::size_t size)
+     */
+    template<typename Writer>
+    void dumpChromeTrace(Writer&& write) const
+    {
+        static const char* const names[] = {"receive", "parse", "dispatch", "handler", "send"};
+        static_assert(sizeof(names) / sizeof(names[0]) == static_cast<std::size_t>(OSCTraceEvent::Count),
+                      "Trace event names out of sync");
+
+        char line[128];
+        bool first = true;
+        write("{\"traceEvents\":[\n", 17);
+
+        for (std::size_t core = 0; core < TRACE_CORES; core++) {
+            const Ring& ring = mRings[core];
+            const std::size_t head = ring.head.load(std::memory_order_acquire);
+            const std::size_t begin = head > TRACE_BUFFER_SIZE ? head - TRACE_BUFFER_SIZE : 0;
+
+            // Unwrap the 32-bit timestamps into a 64-bit timeline (gaps < 2^32 us)
+            uint64_t time = 0;
+            uint32_t previous = 0;
+            for (std::size_t i = begin; i < head; i++) {
+                const Record& rec = ring.records[i & (TRACE_BUFFER_SIZE - 1)];
+                time = (i == begin) ? rec.timestamp : time + (rec.timestamp - previous);
+                previous = rec.timestamp;
+
+                const int len = std::snprintf(
+                    line, sizeof(line),
+                    "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":0,\"tid\":%u,"
+                    "\"args\":{\"size\":%u}}",
+                    first ? "" : ",\n", names[static_cast<std::size_t>(rec.event)], rec.phase,
+                    static_cast<unsigned long long>(time),
+                    static_cast<unsigned>(core), static_cast<unsigned>(rec.size));
+                if (len > 0) write(line, static_cast<std::size_t>(len));
+                first = false;
+            }
+        }
+        write("\n]}\n", 4);
+    }
+
+private:
+    struct Ring
+    {
+        std::atomic<std::size_t> head{0};
+        Record records[TRACE_BUFFER_SIZE];
+    };
+
+    static std::size_t currentCore()
+    {
+#if defined(LIB_PICO_TIME)
+        return get_core_num();
+#else
+        return 0;
+#endif
+    }
+
+    Ring mRings[TRACE_CORES];
+};
+
+/**
+ * Records a begin event now and the matching end event at scope exit
+ */
+class OSCTraceScope
+{
+public:
+    OSCTraceScope(OSCTraceEvent event, std::size_t size)
+        : mEvent(event)
+        , mSize(size)
+    {
+        OSCTracer::instance().record(mEvent, 'B', mSize);
+    }
+
+    ~OSCTraceScope() { OSCTracer::instance().record(mEvent, 'E', mSize); }
+
+    OSCTraceScope(const OSCTraceScope&) = delete;
+    OSCTraceScope& operator=(const OSCTraceScope&) = delete;
+
+private:
+    OSCTraceEvent mEvent;
+    std::size_t mSize;
+};
+
+#define PICOOSC_TRACE_SCOPE(event, size) picoosc::OSCTraceScope picooscTraceScope_(event, size)
+#else
+#define PICOOSC_TRACE_SCOPE(event, size) ((void)0)
+#endif
+
+#if LWIP_SUPPORT_CUSTOM_PBUF
+/**
+ * Preallocated pool of fixed-size pbufs for OSCClient
+ *
+ * Each slot is a pbuf_custom with room for lwIP's headers plus one
+ * MAX_MESSAGE_SIZE packet. Slots are handed out from a free list and
+ * returned by lwIP's custom free callback once the last reference to the
+ * pbuf is dropped (which may be later than udp_sendto() if the driver
+ * queues it). The pool must outlive every client it is attached to.
+ *
+ * Not thread-safe: use from the lwIP context only (poll mode, or between
+ * cyw43_arch_lwip_begin()/end()).
+ */
+class OSCPbufPool
+{
+public:
+    static constexpr std::size_t HEADER_SIZE = PBUF_LINK_ENCAPSULATION_HLEN + PBUF_LINK_HLEN
+                                             + PBUF_IP_HLEN + PBUF_TRANSPORT_HLEN;
+    static constexpr std::size_t SLOT_SIZE = LWIP_MEM_ALIGN_SIZE(HEADER_SIZE) + MAX_MESSAGE_SIZE
+                                           + MEM_ALIGNMENT;
+
+    OSCPbufPool()
+    {
+        for (std::size_t i = 0; i < PBUF_POOL_SLOTS; i++) {
+            mSlots[i].pool = this;
+            mSlots[i].next = (i + 1 < PBUF_POOL_SLOTS) ? &mSlots[i + 1] : nullptr;
+        }
+        mFree = &mSlots[0];
+        mAvailable = PBUF_POOL_SLOTS;
+    }
+
+    // Non-copyable (slots point back at the pool)
+    OSCPbufPool(const OSCPbufPool&) = delete;
+    OSCPbufPool& operator=(const OSCPbufPool&) = delete;
+
+    /**
+     * Take a pbuf with room for size bytes of payload
+     * @return nullptr if the pool is empty or size exceeds MAX_MESSAGE_SIZE
+     */
+    pbuf* alloc(uint16_t size)
+    {
+        if (!mFree || size > MAX_MESSAGE_SIZE) return nullptr;
+
+        Slot* slot = mFree;
+        mFree = slot->next;
+        mAvailable--;
+
+        slot->custom.custom_free_function = &OSCPbufPool::freeSlot;
+        pbuf* p = pbuf_alloced_custom(PBUF_TRANSPORT, size, PBUF_RAM, &slot->custom,
+                                      slot->memory, static_cast<uint16_t>(SLOT_SIZE));
+        if (!p) {
+            release(slot);
+        }
+        return p;
+    }
+
+    std::size_t available() const { return mAvailable; }
+    std::size_t capacity() const { return PBUF_POOL_SLOTS; }
+
+private:
+    struct Slot
+    {
+        pbuf_custom custom;  // Must be first: lwIP hands back the pbuf pointer
+        OSCPbufPool* pool;
+        Slot* next;
+        alignas(MEM_ALIGNMENT) uint8_t memory[SLOT_SIZE];
+    };
+
+    static void freeSlot(pbuf* p)
+    {
+        Slot* slot = reinterpret_cast<Slot*>(p);
+        slot->pool->release(slot);
+    }
+
+    void release(Slot* slot)
+    {
+        slot->next = mFree;
+        mFree = slot;
+        mAvailable++;
+    }
+
+    Slot mSlots[PBUF_POOL_SLOTS];
+    Slot* mFree = nullptr;
+    std::size_t mAvailable = 0;
+};
+#endif
+
 /**
  * UDP client for sending OSC messages
  */
@@ -109,6 +813,9 @@ public:
         : mPcb(other.mPcb)
         , mAddr(other.mAddr)
         , mPort(other.mPort)
+#if LWIP_SUPPORT_CUSTOM_PBUF
+        , mPool(other.mPool)
+#endif
     {
         other.mPcb = nullptr;
     }
@@ -120,6 +827,9 @@ public:
             mPcb = other.mPcb;
             mAddr = other.mAddr;
             mPort = other.mPort;
+#if LWIP_SUPPORT_CUSTOM_PBUF
+            mPool = other.mPool;
+#endif
             other.mPcb = nullptr;
         }
         return *this;
@@ -132,721 +842,3957 @@ public:
     bool send(const char* buffer, uint16_t size)
     {
         if (!mPcb) return false;
+        PICOOSC_TRACE_SCOPE(OSCTraceEvent::Send, size);
 
-        struct pbuf* p = pbuf_alloc(PBUF_TRANSPORT, size, PBUF_RAM);
+        struct pbuf* p = nullptr;
+#if LWIP_SUPPORT_CUSTOM_PBUF
+        if (mPool) {
+            p = mPool->alloc(size);
+            if (!p) mStats.poolFallbacks.add();
+        }
+#endif
         if (!p) {
+            p = pbuf_alloc(PBUF_TRANSPORT, size, PBUF_RAM);
+        }
+        if (!p) {
+            mStats.pbufAllocFailures.add();
+            PICOOSC_LOG_ERROR("picoosc: no pbuf for %u byte packet\n", size);
             return false;
         }
 
         std::memcpy(p->payload, buffer, size);
+#if PICOOSC_STATS && PICOOSC_LATENCY_STATS
+        const uint32_t start = monotonicMicros();
+#endif
         const err_t error = udp_sendto(mPcb, p, &mAddr, mPort);
         pbuf_free(p);
+#if PICOOSC_STATS && PICOOSC_LATENCY_STATS
+        mStats.sendLatency.record(monotonicMicros() - start);
+#endif
 
-        return error == ERR_OK;
+        if (error != ERR_OK) {
+            mStats.sendErrors.add();
+            PICOOSC_LOG_ERROR("picoosc: udp_sendto failed, error=%d\n", error);
+            return false;
+        }
+        mStats.packetsOut.add();
+        mStats.bytesOut.add(size);
+        return true;
     }
 
-    bool isValid() const { return mPcb != nullptr; }
+    /**
+     * Snapshot of the send counters
+     */
+    OSCClientStats stats() const { return mStats.snapshot(); }
+    void resetStats() { mStats.reset(); }
 
-private:
-    udp_pcb* mPcb = nullptr;
-    ip_addr_t mAddr{};
-    uint16_t mPort = 0;
-};
+    bool isValid() const { return mPcb != nullptr; }
 
-/**
- * OSC Message builder
- * 
- * Usage:
- *   OSCMessage msg;
- *   msg.setAddress("/synth/freq");
- *   msg.addFloat(440.0f);
- *   msg.addInt(1);
- *   msg.send(client);
- * 
- * See: https://opensoundcontrol.stanford.edu/spec-1_0-examples.html
- */
-class OSCMessage
-{
-public:
-    OSCMessage() { clear(); }
+#if LWIP_SUPPORT_CUSTOM_PBUF
+    /**
+     * Send from a preallocated pbuf pool instead of the lwIP heap
+     * Falls back to the heap when the pool is empty or the packet is larger
+     * than a slot. Pass nullptr to detach. The pool may be shared.
+     */
+    void setPbufPool(OSCPbufPool* pool) { mPool = pool; }
+    OSCPbufPool* pbufPool() const { return mPool; }
+#endif
 
     /**
-     * Clear the message, resetting all buffers
+     * Allow sending to broadcast addresses (sets SOF_BROADCAST)
+     * Required when the target is e.g. 255.255.255.255 or a subnet broadcast
+     * and lwIP is built with IP_SOF_BROADCAST.
      */
-    void clear()
+    void setBroadcast(bool enable)
     {
-        mAddressSize = 0;
-        mTypeTagCount = 0;
-        mArgBufferSize = 0;
-        std::memset(mAddress, 0, MAX_ADDRESS_SIZE);
-        std::memset(mTypeTags, 0, MAX_TYPE_TAG_SIZE);
-        std::memset(mArgBuffer, 0, MAX_ARG_BUFFER_SIZE);
+        if (!mPcb) return;
+#if IP_SOF_BROADCAST
+        if (enable) {
+            ip_set_option(mPcb, SOF_BROADCAST);
+        } else {
+            ip_reset_option(mPcb, SOF_BROADCAST);
+        }
+#else
+        (void)enable;
+#endif
     }
 
     /**
-     * Set the OSC address pattern (e.g., "/synth/freq")
-     * @return true on success, false if address too long
+     * Set the TTL used for multicast datagrams (default 1, local subnet)
+     * @return false if lwIP is built without LWIP_MULTICAST_TX_OPTIONS
      */
-    bool setAddress(const char* address)
+    bool setMulticastTTL(uint8_t ttl)
     {
-        const std::size_t len = std::strlen(address);
-        if (len >= MAX_ADDRESS_SIZE) {
-            return false;
-        }
-
-        std::memcpy(mAddress, address, len + 1);  // Include null terminator
-        mAddressSize = len + 1;
+        if (!mPcb) return false;
+#if LWIP_MULTICAST_TX_OPTIONS
+        udp_set_multicast_ttl(mPcb, ttl);
+        return true;
+#else
+        (void)ttl;
+        return false;
+#endif
+    }
 
-        // Pad to 4-byte boundary
-        while (mAddressSize % 4 != 0) {
-            mAddress[mAddressSize++] = '\0';
+    /**
+     * Control whether multicast datagrams are looped back to this host
+     * @return false if lwIP is built without LWIP_MULTICAST_TX_OPTIONS
+     */
+    bool setMulticastLoopback(bool enable)
+    {
+        if (!mPcb) return false;
+#if LWIP_MULTICAST_TX_OPTIONS
+        if (enable) {
+            udp_set_flags(mPcb, UDP_FLAGS_MULTICAST_LOOP);
+        } else {
+            udp_clear_flags(mPcb, UDP_FLAGS_MULTICAST_LOOP);
         }
-
         return true;
+#else
+        (void)enable;
+        return false;
+#endif
     }
 
     /**
-     * Add a 32-bit integer argument
+     * Select the local interface address used for outgoing multicast
+     * @return false if the address is invalid or multicast TX is unsupported
      */
-    bool addInt(int32_t value)
+    bool setMulticastInterface(const char* interfaceAddress)
     {
-        if (!canAddArg(4)) return false;
-
-        mTypeTags[mTypeTagCount++] = 'i';
-        value = swap_endian(value);
-        std::memcpy(mArgBuffer + mArgBufferSize, &value, 4);
-        mArgBufferSize += 4;
+        if (!mPcb) return false;
+#if LWIP_MULTICAST_TX_OPTIONS
+        ip_addr_t ifAddr;
+        if (!ipaddr_aton(interfaceAddress, &ifAddr)) return false;
+        udp_set_multicast_netif_addr(mPcb, ip_2_ip4(&ifAddr));
         return true;
+#else
+        (void)interfaceAddress;
+        return false;
+#endif
+    }
+
+    bool isMulticast() const { return ip_addr_ismulticast(&mAddr); }
+
+private:
+    udp_pcb* mPcb = nullptr;
+    ip_addr_t mAddr{};
+    uint16_t mPort = 0;
+#if LWIP_SUPPORT_CUSTOM_PBUF
+    OSCPbufPool* mPool = nullptr;
+#endif
+    OSCClientCounters mStats;
+};
+
+/**
+ * UDP client that sends the same packet to many destinations
+ *
+ * The packet is wrapped once in a PBUF_REF pbuf that references the
+ * caller's buffer, so no payload is copied or allocated per destination.
+ * lwIP prepends its headers in a separate pbuf on every udp_sendto().
+ */
+class OSCClientGroup
+{
+public:
+    OSCClientGroup() { mPcb = udp_new(); }
+
+    ~OSCClientGroup()
+    {
+        if (mPcb) {
+            udp_remove(mPcb);
+        }
     }
 
+    // Non-copyable
+    OSCClientGroup(const OSCClientGroup&) = delete;
+    OSCClientGroup& operator=(const OSCClientGroup&) = delete;
+
     /**
-     * Add a 32-bit float argument
+     * Add a destination
+     * @return false if the address is invalid or the group is full
      */
-    bool addFloat(float value)
+    bool addDestination(const char* address, uint16_t port)
     {
-        if (!canAddArg(4)) return false;
+        if (mDestinationCount >= MAX_GROUP_DESTINATIONS) return false;
 
-        mTypeTags[mTypeTagCount++] = 'f';
-        value = swap_endian_float(value);
-        std::memcpy(mArgBuffer + mArgBufferSize, &value, 4);
-        mArgBufferSize += 4;
+        Destination& dest = mDestinations[mDestinationCount];
+        if (!ipaddr_aton(address, &dest.addr)) return false;
+        dest.port = port;
+        mDestinationCount++;
         return true;
     }
 
     /**
-     * Add a string argument
+     * Remove a destination
+     * @return false if the destination was not found
      */
-    bool addString(const char* value)
+    bool removeDestination(const char* address, uint16_t port)
     {
-        const std::size_t len = std::strlen(value);
-        const std::size_t paddedLen = ((len + 1) + 3) & ~3;  // Round up to 4-byte boundary
+        ip_addr_t addr;
+        if (!ipaddr_aton(address, &addr)) return false;
 
-        if (!canAddArg(paddedLen)) return false;
+        for (std::size_t i = 0; i < mDestinationCount; i++) {
+            if (ip_addr_cmp(&mDestinations[i].addr, &addr) && mDestinations[i].port == port) {
+                mDestinations[i] = mDestinations[--mDestinationCount];
+                return true;
+            }
+        }
+        return false;
+    }
 
-        mTypeTags[mTypeTagCount++] = 's';
+    void clearDestinations() { mDestinationCount = 0; }
+    std::size_t destinationCount() const { return mDestinationCount; }
 
-        // Copy string with null terminator
-        std::memcpy(mArgBuffer + mArgBufferSize, value, len + 1);
-        mArgBufferSize += len + 1;
+    /**
+     * Send raw data to every destination
+     * @return true if the packet was sent to all destinations
+     */
+    bool send(const char* buffer, uint16_t size)
+    {
+        if (!mPcb || mDestinationCount == 0) return false;
+        PICOOSC_TRACE_SCOPE(OSCTraceEvent::Send, size);
 
-        // Pad to 4-byte boundary
-        while (mArgBufferSize % 4 != 0) {
-            mArgBuffer[mArgBufferSize++] = '\0';
+        struct pbuf* p = pbuf_alloc(PBUF_TRANSPORT, size, PBUF_REF);
+        if (!p) {
+            mStats.pbufAllocFailures.add();
+            return false;
+        }
+        p->payload = const_cast<char*>(buffer);
+
+        std::size_t sent = 0;
+        for (std::size_t i = 0; i < mDestinationCount; i++) {
+#if PICOOSC_STATS && PICOOSC_LATENCY_STATS
+            const uint32_t start = monotonicMicros();
+#endif
+            if (udp_sendto(mPcb, p, &mDestinations[i].addr, mDestinations[i].port) == ERR_OK) {
+                sent++;
+            }
+#if PICOOSC_STATS && PICOOSC_LATENCY_STATS
+            mStats.sendLatency.record(monotonicMicros() - start);
+#endif
         }
+        pbuf_free(p);
 
-        return true;
+        mStats.packetsOut.add(static_cast<uint32_t>(sent));
+        mStats.bytesOut.add(static_cast<uint32_t>(sent * size));
+        mStats.sendErrors.add(static_cast<uint32_t>(mDestinationCount - sent));
+        return sent == mDestinationCount;
     }
 
     /**
-     * Add a blob (binary data) argument
+     * Snapshot of the send counters (one packet per destination)
      */
-    bool addBlob(const void* data, int32_t size)
+    OSCClientStats stats() const { return mStats.snapshot(); }
+    void resetStats() { mStats.reset(); }
+
+    bool isValid() const { return mPcb != nullptr; }
+
+private:
+    struct Destination
     {
-        const std::size_t paddedDataLen = (static_cast<std::size_t>(size) + 3) & ~3;
+        ip_addr_t addr;
+        uint16_t port;
+    };
 
-        if (!canAddArg(4 + paddedDataLen)) return false;
+    udp_pcb* mPcb = nullptr;
+    Destination mDestinations[MAX_GROUP_DESTINATIONS]{};
+    std::size_t mDestinationCount = 0;
+    OSCClientCounters mStats;
+};
 
-        mTypeTags[mTypeTagCount++] = 'b';
+/**
+ * Framing used to carry OSC packets over a byte stream (TCP, serial)
+ *
+ * Slip:         OSC 1.1, packets delimited by SLIP END bytes (RFC 1055),
+ *               with an END before and after every packet
+ * LengthPrefix: OSC 1.0, every packet preceded by its big-endian int32 size
+ */
+enum class OSCFraming : uint8_t
+{
+    Slip,
+    LengthPrefix,
+};
 
-        // Write size (big-endian)
-        int32_t beSize = swap_endian(size);
-        std::memcpy(mArgBuffer + mArgBufferSize, &beSize, 4);
-        mArgBufferSize += 4;
+// SLIP special bytes (RFC 1055)
+static constexpr uint8_t SLIP_END = 0xC0;
+static constexpr uint8_t SLIP_ESC = 0xDB;
+static constexpr uint8_t SLIP_ESC_END = 0xDC;
+static constexpr uint8_t SLIP_ESC_ESC = 0xDD;
 
-        // Write data
-        std::memcpy(mArgBuffer + mArgBufferSize, data, static_cast<std::size_t>(size));
-        mArgBufferSize += size;
+/**
+ * Find the first SLIP END or ESC byte
+ * Scans 16 bytes at a time with SSE2, 8 bytes at a time (SWAR) on other
+ * 64-bit hosts, and byte-at-a-time on the Pico where unaligned word loads
+ * are not worth it.
+ * @return Index of the byte, or size if there is none
+ */
+inline std::size_t findSlipSpecial(const char* data, std::size_t size)
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i end = _mm_set1_epi8(static_cast<char>(SLIP_END));
+    const __m128i esc = _mm_set1_epi8(static_cast<char>(SLIP_ESC));
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const int mask = _mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, end), _mm_cmpeq_epi8(v, esc)));
+        if (mask != 0) {
+            return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+#elif UINTPTR_MAX > 0xFFFFFFFFu
+    constexpr uint64_t ones = 0x0101010101010101ULL;
+    constexpr uint64_t highs = 0x8080808080808080ULL;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t v;
+        std::memcpy(&v, data + i, 8);
+        const uint64_t xEnd = v ^ (ones * SLIP_END);
+        const uint64_t xEsc = v ^ (ones * SLIP_ESC);
+        // Non-zero if any byte of xEnd or xEsc is zero
+        const uint64_t hit = ((xEnd - ones) & ~xEnd & highs) | ((xEsc - ones) & ~xEsc & highs);
+        if (hit != 0) break;  // Locate the exact byte below
+    }
+#endif
 
-        // Pad to 4-byte boundary
-        while (mArgBufferSize % 4 != 0) {
-            mArgBuffer[mArgBufferSize++] = '\0';
+    for (; i < size; i++) {
+        const uint8_t c = static_cast<uint8_t>(data[i]);
+        if (c == SLIP_END || c == SLIP_ESC) return i;
+    }
+    return size;
+}
+
+/**
+ * Find the terminator of an OSC string
+ * Scans 32 bytes at a time with AVX2, 16 with SSE2 or NEON, and a word at
+ * a time (SWAR) elsewhere. OSC strings start on a 4-byte boundary, so on
+ * the Pico the word loads are aligned whenever the packet is; an unaligned
+ * packet falls back to byte-at-a-time.
+ * @return Index of the first zero byte, or size if there is none
+ */
+inline std::size_t findOSCTerminator(const char* data, std::size_t size)
+{
+    std::size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 32 <= size; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+        if (mask != 0) return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i zero16 = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero16));
+        if (mask != 0) return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; i + 16 <= size; i += 16) {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        if (vmaxvq_u8(vceqzq_u8(v)) != 0) break;  // Locate the exact byte below
+    }
+#else
+    if ((reinterpret_cast<uintptr_t>(data) & 3) == 0) {
+        constexpr uintptr_t ones = ~uintptr_t(0) / 0xFF;
+        constexpr uintptr_t highs = ones << 7;
+        const char* aligned = static_cast<const char*>(__builtin_assume_aligned(data, 4));
+        for (; i + sizeof(uintptr_t) <= size; i += sizeof(uintptr_t)) {
+            uintptr_t v;
+            std::memcpy(&v, aligned + i, sizeof(v));
+            if (((v - ones) & ~v & highs) != 0) break;  // Some byte is zero
         }
+    }
+#endif
 
-        return true;
+    for (; i < size; i++) {
+        if (data[i] == '\0') return i;
     }
+    return size;
+}
 
-    /**
-     * Add a 64-bit integer argument
-     */
-    bool addInt64(int64_t value)
-    {
-        if (!canAddArg(8)) return false;
+/**
+ * Size of a packet once SLIP encoded, including both END delimiters
+ */
+inline std::size_t slipEncodedSize(const char* data, std::size_t size)
+{
+    std::size_t encoded = size + 2;
+    std::size_t pos = 0;
+    while ((pos += findSlipSpecial(data + pos, size - pos)) < size) {
+        encoded++;
+        pos++;
+    }
+    return encoded;
+}
 
-        mTypeTags[mTypeTagCount++] = 'h';
-        value = swap_endian(value);
-        std::memcpy(mArgBuffer + mArgBufferSize, &value, 8);
-        mArgBufferSize += 8;
-        return true;
+/**
+ * SLIP encode a packet (END + escaped data + END)
+ * @return Number of bytes written, or 0 if outBuffer is too small
+ */
+inline std::size_t slipEncode(const char* data, std::size_t size, char* outBuffer, std::size_t maxSize)
+{
+    if (slipEncodedSize(data, size) > maxSize) return 0;
+
+    std::size_t out = 0;
+    outBuffer[out++] = static_cast<char>(SLIP_END);
+    std::size_t pos = 0;
+    while (pos < size) {
+        const std::size_t run = findSlipSpecial(data + pos, size - pos);
+        std::memcpy(outBuffer + out, data + pos, run);
+        out += run;
+        pos += run;
+        if (pos < size) {
+            const bool isEnd = static_cast<uint8_t>(data[pos]) == SLIP_END;
+            outBuffer[out++] = static_cast<char>(SLIP_ESC);
+            outBuffer[out++] = static_cast<char>(isEnd ? SLIP_ESC_END : SLIP_ESC_ESC);
+            pos++;
+        }
     }
+    outBuffer[out++] = static_cast<char>(SLIP_END);
+    return out;
+}
 
-    /**
-     * Add a 64-bit double argument
-     */
-    bool addDouble(double value)
+/**
+ * Single-producer/single-consumer byte ring over caller-provided storage
+ *
+ * Meant for serial/USB-CDC links where an interrupt handler or driver
+ * callback fills the ring and the main loop drains it (or vice versa for
+ * transmit). Capacity must be a power of two: checked at compile time for
+ * an array, and rounded down to one for a pointer and size.
+ */
+class OSCByteRing
+{
+public:
+    template<std::size_t Capacity>
+    explicit OSCByteRing(char (&storage)[Capacity])
+        : mStorage(storage)
+        , mMask(Capacity - 1)
     {
-        if (!canAddArg(8)) return false;
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                      "OSCByteRing capacity must be a power of two");
+    }
 
-        mTypeTags[mTypeTagCount++] = 'd';
-        value = swap_endian_double(value);
-        std::memcpy(mArgBuffer + mArgBufferSize, &value, 8);
-        mArgBufferSize += 8;
-        return true;
+    OSCByteRing(char* storage, std::size_t capacity)
+        : mStorage(storage)
+        , mMask(floorPow2(capacity) - 1)
+    {
     }
 
-    /**
-     * Add a timetag argument
-     */
-    bool addTimetag(OSCTimetag tt)
+    // Non-copyable
+    OSCByteRing(const OSCByteRing&) = delete;
+    OSCByteRing& operator=(const OSCByteRing&) = delete;
+
+    std::size_t capacity() const { return mMask + 1; }
+
+    std::size_t readable() const
     {
-        if (!canAddArg(8)) return false;
+        return mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_relaxed);
+    }
 
-        mTypeTags[mTypeTagCount++] = 't';
-        tt.seconds = swap_endian(tt.seconds);
-        tt.fractions = swap_endian(tt.fractions);
-        std::memcpy(mArgBuffer + mArgBufferSize, &tt.seconds, 4);
-        std::memcpy(mArgBuffer + mArgBufferSize + 4, &tt.fractions, 4);
-        mArgBufferSize += 8;
-        return true;
+    std::size_t writable() const
+    {
+        return capacity() - (mHead.load(std::memory_order_relaxed)
+                             - mTail.load(std::memory_order_acquire));
     }
 
     /**
-     * Add a True value (no data, just type tag)
+     * Append one byte (producer side)
+     * @return false if the ring is full
      */
-    bool addTrue()
+    bool push(char c)
     {
-        if (mTypeTagCount >= MAX_TYPE_TAG_SIZE - 1) return false;
-        mTypeTags[mTypeTagCount++] = 'T';
+        const std::size_t head = mHead.load(std::memory_order_relaxed);
+        if (head - mTail.load(std::memory_order_acquire) > mMask) return false;
+        mStorage[head & mMask] = c;
+        mHead.store(head + 1, std::memory_order_release);
         return true;
     }
 
     /**
-     * Add a False value (no data, just type tag)
+     * Append up to size bytes (producer side)
+     * @return Number of bytes written
      */
-    bool addFalse()
+    std::size_t write(const char* data, std::size_t size)
     {
-        if (mTypeTagCount >= MAX_TYPE_TAG_SIZE - 1) return false;
-        mTypeTags[mTypeTagCount++] = 'F';
-        return true;
+        const std::size_t head = mHead.load(std::memory_order_relaxed);
+        const std::size_t space = capacity() - (head - mTail.load(std::memory_order_acquire));
+        if (size > space) size = space;
+
+        const std::size_t offset = head & mMask;
+        const std::size_t first = (size < capacity() - offset) ? size : capacity() - offset;
+        std::memcpy(mStorage + offset, data, first);
+        std::memcpy(mStorage, data + first, size - first);
+        mHead.store(head + size, std::memory_order_release);
+        return size;
     }
 
     /**
-     * Add a Nil value (no data, just type tag)
+     * Remove one byte (consumer side)
+     * @return false if the ring is empty
      */
-    bool addNil()
+    bool pop(char& c)
     {
-        if (mTypeTagCount >= MAX_TYPE_TAG_SIZE - 1) return false;
-        mTypeTags[mTypeTagCount++] = 'N';
+        const std::size_t tail = mTail.load(std::memory_order_relaxed);
+        if (mHead.load(std::memory_order_acquire) == tail) return false;
+        c = mStorage[tail & mMask];
+        mTail.store(tail + 1, std::memory_order_release);
         return true;
     }
 
     /**
-     * Add an Infinitum value (no data, just type tag)
+     * Largest contiguous readable span (consumer side)
+     * Call consume() once the bytes have been processed.
      */
-    bool addInfinitum()
+    const char* peek(std::size_t& size) const
     {
-        if (mTypeTagCount >= MAX_TYPE_TAG_SIZE - 1) return false;
-        mTypeTags[mTypeTagCount++] = 'I';
-        return true;
+        const std::size_t tail = mTail.load(std::memory_order_relaxed);
+        const std::size_t available = mHead.load(std::memory_order_acquire) - tail;
+        const std::size_t offset = tail & mMask;
+        size = (available < capacity() - offset) ? available : capacity() - offset;
+        return mStorage + offset;
     }
 
-    /**
-     * Add a MIDI message (4 bytes: port, status, data1, data2)
-     */
-    bool addMidi(uint8_t port, uint8_t status, uint8_t data1, uint8_t data2)
+    void consume(std::size_t size)
     {
-        if (!canAddArg(4)) return false;
+        mTail.store(mTail.load(std::memory_order_relaxed) + size, std::memory_order_release);
+    }
 
-        mTypeTags[mTypeTagCount++] = 'm';
-        mArgBuffer[mArgBufferSize++] = static_cast<char>(port);
-        mArgBuffer[mArgBufferSize++] = static_cast<char>(status);
-        mArgBuffer[mArgBufferSize++] = static_cast<char>(data1);
-        mArgBuffer[mArgBufferSize++] = static_cast<char>(data2);
-        return true;
+private:
+    static constexpr std::size_t floorPow2(std::size_t n)
+    {
+        std::size_t p = 1;
+        while (p <= n / 2) p <<= 1;
+        return p;
+    }
+
+    char* mStorage;
+    std::size_t mMask;
+    std::atomic<std::size_t> mHead{0};
+    std::atomic<std::size_t> mTail{0};
+};
+
+/**
+ * SLIP encode a packet into a ring (e.g. a UART transmit queue)
+ * The frame is written whole or not at all.
+ * @return false if the ring does not have room for the encoded frame
+ */
+inline bool slipEncode(const char* data, std::size_t size, OSCByteRing& out)
+{
+    if (out.writable() < slipEncodedSize(data, size)) return false;
+
+    const char end = static_cast<char>(SLIP_END);
+    out.write(&end, 1);
+    std::size_t pos = 0;
+    while (pos < size) {
+        const std::size_t run = findSlipSpecial(data + pos, size - pos);
+        out.write(data + pos, run);
+        pos += run;
+        if (pos < size) {
+            const bool isEnd = static_cast<uint8_t>(data[pos]) == SLIP_END;
+            const char escaped[2] = {static_cast<char>(SLIP_ESC),
+                                     static_cast<char>(isEnd ? SLIP_ESC_END : SLIP_ESC_ESC)};
+            out.write(escaped, 2);
+            pos++;
+        }
+    }
+    out.write(&end, 1);
+    return true;
+}
+
+#if LWIP_TCP
+/**
+ * TCP client for sending OSC packets over a reliable stream
+ *
+ * connect() is asynchronous; send() fails until isConnected() is true.
+ * Not movable: lwIP callbacks hold a pointer to the client.
+ */
+class OSCTcpClient
+{
+public:
+    OSCTcpClient(const char* address, uint16_t port, OSCFraming framing = OSCFraming::Slip)
+        : mPort(port)
+        , mFraming(framing)
+    {
+        ipaddr_aton(address, &mAddr);
     }
 
+    ~OSCTcpClient() { close(); }
+
+    // Non-copyable
+    OSCTcpClient(const OSCTcpClient&) = delete;
+    OSCTcpClient& operator=(const OSCTcpClient&) = delete;
+
     /**
-     * Add a character argument
+     * Start connecting to the server
+     * @return false if already connected/connecting or the connect failed
      */
-    bool addChar(char c)
+    bool connect()
     {
-        if (!canAddArg(4)) return false;
+        if (mPcb) return false;
 
-        mTypeTags[mTypeTagCount++] = 'c';
-        // Character is stored as a 32-bit value (big-endian, char in last byte)
-        mArgBuffer[mArgBufferSize++] = '\0';
-        mArgBuffer[mArgBufferSize++] = '\0';
-        mArgBuffer[mArgBufferSize++] = '\0';
-        mArgBuffer[mArgBufferSize++] = c;
+        mPcb = tcp_new();
+        if (!mPcb) return false;
+
+        tcp_arg(mPcb, this);
+        tcp_err(mPcb, &OSCTcpClient::tcpErrCallback);
+        tcp_recv(mPcb, &OSCTcpClient::tcpRecvCallback);
+
+        if (tcp_connect(mPcb, &mAddr, mPort, &OSCTcpClient::tcpConnectedCallback) != ERR_OK) {
+            tcp_abort(mPcb);
+            mPcb = nullptr;
+            return false;
+        }
         return true;
     }
 
     /**
-     * Add an RGBA color argument
+     * Close the connection
      */
-    bool addColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+    void close()
     {
-        if (!canAddArg(4)) return false;
-
-        mTypeTags[mTypeTagCount++] = 'r';
-        mArgBuffer[mArgBufferSize++] = static_cast<char>(r);
-        mArgBuffer[mArgBufferSize++] = static_cast<char>(g);
-        mArgBuffer[mArgBufferSize++] = static_cast<char>(b);
-        mArgBuffer[mArgBufferSize++] = static_cast<char>(a);
-        return true;
+        if (mPcb) {
+            detach(mPcb);
+            if (tcp_close(mPcb) != ERR_OK) {
+                tcp_abort(mPcb);
+            }
+            mPcb = nullptr;
+        }
+        mConnected = false;
     }
 
     /**
-     * Build the complete OSC message into the provided buffer
-     * @param outBuffer Buffer to write to
-     * @param maxSize Maximum size of the buffer
-     * @return Number of bytes written, or 0 on error
+     * Send one framed OSC packet
+     * @return false if not connected or the send buffer or segment queue
+     *         is full. The connection is aborted if a frame could only be
+     *         written partially, since the receiver cannot tell it apart
+     *         from a complete one.
      */
-    std::size_t build(char* outBuffer, std::size_t maxSize) const
+    bool send(const char* buffer, uint16_t size)
     {
-        // Calculate total size needed
-        const std::size_t typeTagSize = 1 + mTypeTagCount + 1;  // comma + tags + null
-        const std::size_t typeTagPadded = (typeTagSize + 3) & ~3;
-        const std::size_t totalSize = mAddressSize + typeTagPadded + mArgBufferSize;
+        if (!mPcb || !mConnected) return false;
+        PICOOSC_TRACE_SCOPE(OSCTraceEvent::Send, size);
 
-        if (totalSize > maxSize || mAddressSize == 0) {
-            return 0;
+        const bool ok = (mFraming == OSCFraming::Slip) ? writeSlip(buffer, size)
+                                                       : writeLengthPrefixed(buffer, size);
+        if (!ok || tcp_output(mPcb) != ERR_OK) {
+            mStats.sendErrors.add();
+            return false;
         }
+        mStats.packetsOut.add();
+        mStats.bytesOut.add(size);
+        return true;
+    }
 
-        std::size_t pos = 0;
+    /**
+     * Snapshot of the send counters
+     */
+    OSCClientStats stats() const { return mStats.snapshot(); }
+    void resetStats() { mStats.reset(); }
 
-        // Write address
-        std::memcpy(outBuffer + pos, mAddress, mAddressSize);
-        pos += mAddressSize;
+    bool isConnected() const { return mConnected; }
+    OSCFraming framing() const { return mFraming; }
 
-        // Write type tag string: comma + types + null + padding
-        outBuffer[pos++] = ',';
-        std::memcpy(outBuffer + pos, mTypeTags, mTypeTagCount);
-        pos += mTypeTagCount;
-        outBuffer[pos++] = '\0';
-        while (pos % 4 != 0) {
-            outBuffer[pos++] = '\0';
-        }
+private:
+    static constexpr std::size_t WRITE_CHUNK_SIZE = 128;
 
-        // Write arguments
-        std::memcpy(outBuffer + pos, mArgBuffer, mArgBufferSize);
-        pos += mArgBufferSize;
+    /**
+     * Whether a frame of the given size fits in the send buffer and the
+     * segment queue when written with at most the given number of calls
+     */
+    bool canQueue(std::size_t bytes, std::size_t writes) const
+    {
+        return tcp_sndbuf(mPcb) >= bytes && tcp_sndqueuelen(mPcb) + writes <= TCP_SND_QUEUELEN;
+    }
 
-        return pos;
+    bool writeLengthPrefixed(const char* buffer, uint16_t size)
+    {
+        if (!canQueue(4u + size, 2)) return false;
+
+        const int32_t beSize = swap_endian(static_cast<int32_t>(size));
+        if (tcp_write(mPcb, &beSize, 4, TCP_WRITE_FLAG_COPY | TCP_WRITE_FLAG_MORE) != ERR_OK) {
+            return false;
+        }
+        if (tcp_write(mPcb, buffer, size, TCP_WRITE_FLAG_COPY) != ERR_OK) {
+            abort();
+            return false;
+        }
+        return true;
     }
 
-    /**
-     * Send the message using an OSCClient
-     * @return true on success, false on failure
-     */
-    bool send(OSCClient& client) const
+    bool writeSlip(const char* buffer, uint16_t size)
     {
-        char buffer[MAX_MESSAGE_SIZE];
-        const std::size_t size = build(buffer, MAX_MESSAGE_SIZE);
-        if (size == 0) {
+        // Every flush but the last writes at least WRITE_CHUNK_SIZE - 2 bytes
+        const std::size_t encodedSize = slipEncodedSize(buffer, size);
+        if (!canQueue(encodedSize, encodedSize / (WRITE_CHUNK_SIZE - 2) + 1)) return false;
+
+        // Escape through a small stack buffer to keep stack usage bounded.
+        // The receiver would deliver a partially written frame as a whole
+        // packet at the next END, so a write that fails after the first
+        // chunk aborts the connection.
+        char chunk[WRITE_CHUNK_SIZE];
+        std::size_t chunkSize = 0;
+        bool started = false;
+        auto flush = [&](uint8_t flags) {
+            const err_t err = tcp_write(mPcb, chunk, static_cast<uint16_t>(chunkSize),
+                                        TCP_WRITE_FLAG_COPY | flags);
+            chunkSize = 0;
+            if (err == ERR_OK) {
+                started = true;
+                return true;
+            }
+            if (started) abort();
+            return false;
+        };
+
+        chunk[chunkSize++] = static_cast<char>(SLIP_END);
+        for (std::size_t pos = 0; pos < size; pos++) {
+            if (chunkSize + 2 > WRITE_CHUNK_SIZE && !flush(TCP_WRITE_FLAG_MORE)) {
+                return false;
+            }
+
+            const uint8_t c = static_cast<uint8_t>(buffer[pos]);
+            if (c == SLIP_END || c == SLIP_ESC) {
+                chunk[chunkSize++] = static_cast<char>(SLIP_ESC);
+                chunk[chunkSize++] = static_cast<char>(c == SLIP_END ? SLIP_ESC_END : SLIP_ESC_ESC);
+            } else {
+                chunk[chunkSize++] = static_cast<char>(c);
+            }
+        }
+        if (chunkSize + 1 > WRITE_CHUNK_SIZE && !flush(TCP_WRITE_FLAG_MORE)) {
             return false;
         }
-        return client.send(buffer, static_cast<uint16_t>(size));
+        chunk[chunkSize++] = static_cast<char>(SLIP_END);
+        return flush(0);
     }
 
-    // Accessors for debugging
-    std::size_t addressSize() const { return mAddressSize; }
-    std::size_t typeTagCount() const { return mTypeTagCount; }
-    std::size_t argBufferSize() const { return mArgBufferSize; }
+    void abort()
+    {
+        if (mPcb) {
+            detach(mPcb);
+            tcp_abort(mPcb);
+            mPcb = nullptr;
+        }
+        mConnected = false;
+    }
 
-private:
-    bool canAddArg(std::size_t bytes) const
+    static void detach(tcp_pcb* pcb)
     {
-        return (mTypeTagCount < MAX_TYPE_TAG_SIZE - 1) &&
-               (mArgBufferSize + bytes <= MAX_ARG_BUFFER_SIZE);
+        tcp_arg(pcb, nullptr);
+        tcp_err(pcb, nullptr);
+        tcp_recv(pcb, nullptr);
     }
 
-    char mAddress[MAX_ADDRESS_SIZE];
-    std::size_t mAddressSize = 0;
+    static err_t tcpConnectedCallback(void* arg, tcp_pcb* pcb, err_t err)
+    {
+        OSCTcpClient* client = static_cast<OSCTcpClient*>(arg);
+        if (!client) return ERR_ARG;
 
-    char mTypeTags[MAX_TYPE_TAG_SIZE];
-    std::size_t mTypeTagCount = 0;
+        client->mConnected = (err == ERR_OK);
+        if (client->mConnected) {
+            tcp_nagle_disable(pcb);
+        }
+        return ERR_OK;
+    }
 
-    char mArgBuffer[MAX_ARG_BUFFER_SIZE];
-    std::size_t mArgBufferSize = 0;
+    static err_t tcpRecvCallback(void* arg, tcp_pcb* pcb, pbuf* p, err_t err)
+    {
+        (void)err;
+        OSCTcpClient* client = static_cast<OSCTcpClient*>(arg);
+
+        if (!p) {
+            // Remote side closed the connection
+            if (client) client->close();
+            return ERR_OK;
+        }
+
+        // Replies are not handled by the client; acknowledge and drop them
+        tcp_recved(pcb, p->tot_len);
+        pbuf_free(p);
+        return ERR_OK;
+    }
+
+    static void tcpErrCallback(void* arg, err_t err)
+    {
+        (void)err;
+        // lwIP has already freed the pcb
+        OSCTcpClient* client = static_cast<OSCTcpClient*>(arg);
+        if (client) {
+            client->mPcb = nullptr;
+            client->mConnected = false;
+        }
+    }
+
+    tcp_pcb* mPcb = nullptr;
+    ip_addr_t mAddr{};
+    uint16_t mPort = 0;
+    OSCFraming mFraming;
+    bool mConnected = false;
+    OSCClientCounters mStats;
 };
+#endif
 
 /**
- * OSC Bundle builder
- * 
- * A bundle contains a timetag and multiple messages.
- * Bundles can be nested (bundles containing bundles).
+ * Last-value cache for high-rate continuous controls
+ *
+ * Keeps only the newest message per address in a fixed open-addressing
+ * table. OSCDispatcher delivers each pending address at most once per
+ * poll(), so handler load is bounded by the poll rate rather than by
+ * how fast a controller sends; OSCSendQueue uses the same table on the
+ * sending side. Addresses registered with setPassthrough() (triggers,
+ * notes, other events) are never coalesced.
+ *
+ * Once all COALESCE_SLOTS entries are taken, a new address reuses the
+ * least recently stored Idle slot (one whose value was delivered), so
+ * one-shot addresses do not lock later faders out. Messages larger than
+ * COALESCE_SLOT_SIZE, and new addresses while every slot is pending or
+ * passthrough, are not cached and must be handled immediately.
+ * Addresses are matched as sent, so an aliased message is keyed by its
+ * alias id.
  */
-class OSCBundle
+class OSCCoalescer
 {
 public:
-    static constexpr std::size_t MAX_BUNDLE_SIZE = 4096;
-
-    OSCBundle() { clear(); }
+    OSCCoalescer() { clear(); }
 
     void clear()
     {
-        mBufferSize = 0;
-        std::memset(mBuffer, 0, MAX_BUNDLE_SIZE);
+        for (Slot& slot : mSlots) {
+            slot.state = Empty;
+            slot.size = 0;
+            slot.keySize = 0;
+            slot.stamp = 0;
+        }
+        mPending = 0;
+        mCursor = 0;
+        mStamp = 0;
+    }
 
-        // Write bundle header "#bundle\0"
-        static const char header[] = "#bundle";
-        std::memcpy(mBuffer, header, 8);
-        mBufferSize = 8;
+    /**
+     * Always dispatch messages for this address immediately
+     * @return false if the address is too long or no slot is free
+     */
+    bool setPassthrough(const char* address)
+    {
+        const std::size_t len = std::strlen(address);
+        if (len == 0 || len >= COALESCE_SLOT_SIZE) return false;
+
+        Slot* slot = lookup(address, len);
+        if (!slot) return false;
+        if (slot->state == Pending) mPending--;
+        std::memcpy(slot->data, address, len + 1);
+        slot->keySize = static_cast<uint16_t>(len);
+        slot->size = 0;
+        slot->state = Passthrough;
+        return true;
+    }
 
-        // Reserve space for timetag (will be set later)
-        mBufferSize += 8;
+    /**
+     * Cache a message as the newest value for its address
+     * @param replaced Set to true if an undelivered value was overwritten
+     * @return true if cached, false if the caller should dispatch it now
+     */
+    bool store(const char* buffer, std::size_t size, bool& replaced)
+    {
+        replaced = false;
+        if (size > COALESCE_SLOT_SIZE) return false;
+
+        const std::size_t keySize = addressLength(buffer, size);
+        if (keySize == 0) return false;
+
+        Slot* slot = lookup(buffer, keySize);
+        if (!slot || slot->state == Passthrough) return false;
+
+        replaced = slot->state == Pending;
+        if (!replaced) mPending++;
+        std::memcpy(slot->data, buffer, size);
+        slot->size = static_cast<uint16_t>(size);
+        slot->state = Pending;
+        slot->stamp = ++mStamp;
+        return true;
     }
 
     /**
-     * Set the bundle timetag
+     * Hand every pending message to handler(const char* data, std::size_t size)
+     * @return Number of messages delivered
      */
-    void setTimetag(OSCTimetag tt)
+    template<typename Handler>
+    std::size_t flush(Handler&& handler)
     {
-        uint32_t seconds = swap_endian(tt.seconds);
-        uint32_t fractions = swap_endian(tt.fractions);
-        std::memcpy(mBuffer + 8, &seconds, 4);
-        std::memcpy(mBuffer + 12, &fractions, 4);
+        return flushWhile([&handler](const char* data, std::size_t size) {
+            handler(data, size);
+            return true;
+        });
     }
 
     /**
-     * Add a message to the bundle
-     * @return true on success, false if bundle is full
+     * Like flush(), but stops as soon as the handler returns false
+     *
+     * The refused message stays pending and the next call starts with it,
+     * so a tight budget rotates through the table instead of starving the
+     * later slots. The handler gets a copy of the message and the slot is
+     * already marked delivered, so a value stored for the same address from
+     * inside the handler is kept pending for the next flush. A refused
+     * message is only put back if no newer value arrived meanwhile.
      */
-    bool addMessage(const OSCMessage& msg)
+    template<typename Handler>
+    std::size_t flushWhile(Handler&& handler)
     {
-        char msgBuffer[OSCMessage::MAX_MESSAGE_SIZE];
-        const std::size_t msgSize = msg.build(msgBuffer, sizeof(msgBuffer));
-        if (msgSize == 0) {
-            return false;
+        std::size_t delivered = 0;
+        char copy[COALESCE_SLOT_SIZE];
+        for (std::size_t i = 0; i < COALESCE_SLOTS && mPending > 0; i++) {
+            const std::size_t index = (mCursor + i) & (COALESCE_SLOTS - 1);
+            Slot& slot = mSlots[index];
+            if (slot.state != Pending) continue;
+            const std::size_t size = slot.size;
+            std::memcpy(copy, slot.data, size);
+            slot.state = Idle;
+            mPending--;
+            mInFlight = &slot;  // Not reclaimed while the handler runs
+            const bool accepted = handler(static_cast<const char*>(copy), size);
+            mInFlight = nullptr;
+            if (!accepted) {
+                if (slot.state == Idle) {
+                    slot.state = Pending;
+                    mPending++;
+                }
+                mCursor = index;
+                return delivered;
+            }
+            delivered++;
         }
+        return delivered;
+    }
 
-        // Check if we have space (4 bytes for size + message)
-        if (mBufferSize + 4 + msgSize > MAX_BUNDLE_SIZE) {
-            return false;
-        }
+    std::size_t pending() const { return mPending; }
 
-        // Write message size (big-endian)
-        int32_t beSize = swap_endian(static_cast<int32_t>(msgSize));
-        std::memcpy(mBuffer + mBufferSize, &beSize, 4);
-        mBufferSize += 4;
+private:
+    enum State : uint8_t
+    {
+        Empty,
+        Idle,         // Address known, latest value already delivered
+        Pending,      // Holds an undelivered value
+        Passthrough,  // Opted out of coalescing
+    };
 
-        // Write message content
-        std::memcpy(mBuffer + mBufferSize, msgBuffer, msgSize);
-        mBufferSize += msgSize;
+    struct Slot
+    {
+        uint32_t hash;
+        uint16_t size;
+        uint16_t keySize;
+        State state;
+        uint32_t stamp;  // mStamp at the last store(), for reclaiming
+        char data[COALESCE_SLOT_SIZE];
+    };
 
-        return true;
+    static_assert((COALESCE_SLOTS & (COALESCE_SLOTS - 1)) == 0, "COALESCE_SLOTS must be a power of two");
+
+    /**
+     * Bytes identifying the address: the string, or the 4-byte alias id
+     */
+    static std::size_t addressLength(const char* buffer, std::size_t size)
+    {
+        if (size < 4) return 0;
+        if (buffer[0] == '\0') return 4;
+        if (buffer[0] != '/') return 0;
+        const void* end = std::memchr(buffer, '\0', size);
+        return end ? static_cast<std::size_t>(static_cast<const char*>(end) - buffer) : 0;
+    }
+
+    static uint32_t hashKey(const char* key, std::size_t size)
+    {
+        uint32_t hash = 2166136261u;  // FNV-1a
+        for (std::size_t i = 0; i < size; i++) {
+            hash = (hash ^ static_cast<uint8_t>(key[i])) * 16777619u;
+        }
+        return hash;
     }
 
     /**
-     * Get the bundle data
+     * Find the slot for a key, claiming an empty one if needed, or else
+     * the least recently stored Idle one
+     * @return nullptr if the key is new and no slot can be claimed
      */
-    const char* data() const { return mBuffer; }
+    Slot* lookup(const char* key, std::size_t keySize)
+    {
+        const uint32_t hash = hashKey(key, keySize);
+        Slot* victim = nullptr;
+        for (std::size_t probe = 0; probe < COALESCE_SLOTS; probe++) {
+            Slot& slot = mSlots[(hash + probe) & (COALESCE_SLOTS - 1)];
+            if (slot.state == Empty) return claim(slot, hash, key, keySize);
+            if (slot.hash == hash && slot.keySize == keySize &&
+                std::memcmp(slot.data, key, keySize) == 0) {
+                return &slot;
+            }
+            if (slot.state == Idle && &slot != mInFlight &&
+                (!victim || mStamp - slot.stamp > mStamp - victim->stamp)) {
+                victim = &slot;
+            }
+        }
+        return victim ? claim(*victim, hash, key, keySize) : nullptr;
+    }
+
+    Slot* claim(Slot& slot, uint32_t hash, const char* key, std::size_t keySize)
+    {
+        slot.hash = hash;
+        slot.stamp = mStamp;
+        slot.keySize = static_cast<uint16_t>(keySize);
+        slot.state = Idle;
+        slot.size = 0;
+        std::memcpy(slot.data, key, keySize);
+        return &slot;
+    }
+
+    Slot mSlots[COALESCE_SLOTS];
+    std::size_t mPending = 0;
+    std::size_t mCursor = 0;
+    uint32_t mStamp = 0;
+    const Slot* mInFlight = nullptr;
+};
+
+/**
+ * Token bucket measured in micro-tokens, refilled from monotonicMicros()
+ * A rate of 0 means unlimited.
+ */
+class OSCTokenBucket
+{
+public:
+    void configure(uint32_t ratePerSecond, uint32_t burst)
+    {
+        mRate = ratePerSecond;
+        mCapacity = static_cast<int64_t>(burst > 0 ? burst : 1) * 1000000;
+        mTokens = mCapacity;
+        mLast = monotonicMicros();
+    }
+
+    void refill(uint32_t now)
+    {
+        const uint32_t elapsed = now - mLast;
+        mLast = now;
+        if (mRate == 0) return;
+        mTokens += static_cast<int64_t>(elapsed) * mRate;
+        if (mTokens > mCapacity) mTokens = mCapacity;
+    }
 
     /**
-     * Get the bundle size
+     * Costs above the burst size are allowed once the bucket is full
      */
-    std::size_t size() const { return mBufferSize; }
+    bool available(uint32_t cost) const
+    {
+        if (mRate == 0) return true;
+        const int64_t needed = static_cast<int64_t>(cost) * 1000000;
+        return mTokens >= (needed < mCapacity ? needed : mCapacity);
+    }
 
     /**
-     * Send the bundle using an OSCClient
+     * May go into debt, which later refills pay back
      */
-    bool send(OSCClient& client) const
+    void take(uint32_t cost)
     {
-        return client.send(mBuffer, static_cast<uint16_t>(mBufferSize));
+        if (mRate != 0) mTokens -= static_cast<int64_t>(cost) * 1000000;
     }
 
 private:
-    char mBuffer[MAX_BUNDLE_SIZE];
-    std::size_t mBufferSize = 0;
-
-    static constexpr std::size_t MAX_MESSAGE_SIZE = 1024;
+    uint32_t mRate = 0;
+    int64_t mCapacity = 0;
+    int64_t mTokens = 0;
+    uint32_t mLast = 0;
 };
 
 /**
- * Parsed OSC argument
+ * Send queue statistics
  */
-struct OSCArg
+struct OSCSendQueueStats
 {
-    char type;
-    union {
-        int32_t i;
-        float f;
-        int64_t h;
-        double d;
-        OSCTimetag t;
-        struct { uint8_t port, status, data1, data2; } midi;
-        struct { uint8_t r, g, b, a; } color;
-        char c;
-    };
-    const char* s;           // For strings (points into original buffer)
-    const uint8_t* blobData; // For blobs (points into original buffer)
-    int32_t blobSize;        // For blobs
+    uint32_t coalescedMessages = 0;  // Replaced by a newer value before sending
+    uint32_t immediateSends = 0;     // Bypassed the queue (passthrough, oversized, no free slot)
+    uint32_t deferredFlushes = 0;    // flush() calls stopped by the rate limit
 };
 
 /**
- * Parsed OSC message (read-only view into received data)
+ * Rate-limited, coalescing send queue in front of one OSCClient
+ *
+ * send() keeps only the newest unsent message per address. flush() sends
+ * pending messages while the packet and byte budgets allow, so a fast
+ * sensor loop costs the network no more than the configured rate.
+ * Messages that bypass the queue (passthrough addresses, messages larger
+ * than COALESCE_SLOT_SIZE, new addresses when no slot is free) go out
+ * immediately but are still charged to the budget.
+ *
+ * Usage:
+ *   OSCSendQueue queue(client);
+ *   queue.setPacketRate(100);       // 100 packets/s
+ *   msg.send(queue);                // as often as you like
+ *   queue.flush();                  // every loop iteration
  */
-class OSCMessageView
+class OSCSendQueue
 {
 public:
-    OSCMessageView() { clear(); }
+    explicit OSCSendQueue(OSCClient& client)
+        : mClient(client)
+    {
+    }
 
-    void clear()
+    OSCSendQueue(const OSCSendQueue&) = delete;
+    OSCSendQueue& operator=(const OSCSendQueue&) = delete;
+
+    /**
+     * Limit packets per second (0 = unlimited)
+     * @param burst Packets that may be sent back to back
+     */
+    void setPacketRate(uint32_t perSecond, uint32_t burst = 1) { mPackets.configure(perSecond, burst); }
+
+    /**
+     * Limit bytes per second (0 = unlimited)
+     * @param burst Bytes that may be sent back to back
+     */
+    void setByteRate(uint32_t perSecond, uint32_t burst = MAX_MESSAGE_SIZE)
     {
-        mAddress = nullptr;
-        mTypeTags = nullptr;
-        mArgCount = 0;
+        mBytes.configure(perSecond, burst);
     }
 
     /**
-     * Parse an OSC message from a buffer
-     * @return true if valid OSC message, false otherwise
+     * Never coalesce this address (triggers, notes, other events)
+     */
+    bool setPassthrough(const char* address) { return mPending.setPassthrough(address); }
+
+    /**
+     * Queue a built message, replacing any unsent one with the same address
+     *
+     * A message that cannot be queued is sent at once without checking
+     * the budget, then charged to it; the buckets may go into debt, which
+     * delays the following flush() calls until refills pay it back.
+     * @return false only if an immediate send failed
      */
-    bool parse(const char* buffer, std::size_t size)
+    bool send(const char* buffer, uint16_t size)
     {
-        clear();
-        if (size < 4 || buffer[0] != '/') {
-            return false;  // Must start with '/'
+        bool replaced = false;
+        if (mPending.store(buffer, size, replaced)) {
+            if (replaced) mStats.coalescedMessages.add();
+            return true;
         }
 
+        mStats.immediateSends.add();
+        mPackets.take(1);
+        mBytes.take(size);
+        return mClient.send(buffer, size);
+    }
+
+    /**
+     * Send pending messages within the current budget
+     * @return Number of messages sent
+     */
+    std::size_t flush()
+    {
+        if (mPending.pending() == 0) return 0;
+
+        const uint32_t now = monotonicMicros();
+        mPackets.refill(now);
+        mBytes.refill(now);
+
+        const std::size_t sent = mPending.flushWhile([this](const char* data, std::size_t size) {
+            const uint32_t bytes = static_cast<uint32_t>(size);
+            if (!mPackets.available(1) || !mBytes.available(bytes)) return false;
+            mPackets.take(1);
+            mBytes.take(bytes);
+            mClient.send(data, static_cast<uint16_t>(size));  // Failures count in the client stats
+            return true;
+        });
+        if (mPending.pending() > 0) mStats.deferredFlushes.add();
+        return sent;
+    }
+
+    /**
+     * Drop all unsent messages (passthrough addresses are kept)
+     */
+    void discard()
+    {
+        mPending.flush([](const char*, std::size_t) {});
+    }
+
+    std::size_t pending() const { return mPending.pending(); }
+    OSCClient& client() const { return mClient; }
+
+    OSCSendQueueStats stats() const
+    {
+        OSCSendQueueStats stats;
+        stats.coalescedMessages = mStats.coalescedMessages.value();
+        stats.immediateSends = mStats.immediateSends.value();
+        stats.deferredFlushes = mStats.deferredFlushes.value();
+        return stats;
+    }
+
+    void resetStats()
+    {
+        mStats.coalescedMessages.reset();
+        mStats.immediateSends.reset();
+        mStats.deferredFlushes.reset();
+    }
+
+private:
+    struct Counters
+    {
+        OSCCounter coalescedMessages;
+        OSCCounter immediateSends;
+        OSCCounter deferredFlushes;
+    };
+
+    OSCClient& mClient;
+    OSCCoalescer mPending;
+    OSCTokenBucket mPackets;
+    OSCTokenBucket mBytes;
+    Counters mStats;
+};
+
+/**
+ * OSC Message builder
+ * 
+ * Usage:
+ *   OSCMessage msg;
+ *   msg.setAddress("/synth/freq");
+ *   msg.addFloat(440.0f);
+ *   msg.addInt(1);
+ *   msg.send(client);
+ * 
+ * See: https://opensoundcontrol.stanford.edu/spec-1_0-examples.html
+ */
+class OSCMessage
+{
+public:
+    OSCMessage() { clear(); }
+
+    /**
+     * Clear the message, resetting all buffers
+     */
+    void clear()
+    {
+        mAddressSize = 0;
+        mTypeTagCount = 0;
+        mArgBufferSize = 0;
+        std::memset(mAddress, 0, MAX_ADDRESS_SIZE);
+        std::memset(mTypeTags, 0, MAX_TYPE_TAG_SIZE);
+        std::memset(mArgBuffer, 0, MAX_ARG_BUFFER_SIZE);
+    }
+
+    /**
+     * Set the OSC address pattern (e.g., "/synth/freq")
+     * @return true on success, false if address too long
+     */
+    bool setAddress(const char* address)
+    {
+        const std::size_t len = std::strlen(address);
+        if (len >= MAX_ADDRESS_SIZE) {
+            return false;
+        }
+
+        std::memcpy(mAddress, address, len + 1);  // Include null terminator
+        mAddressSize = len + 1;
+
+        // Pad to 4-byte boundary
+        while (mAddressSize % 4 != 0) {
+            mAddress[mAddressSize++] = '\0';
+        }
+
+        return true;
+    }
+
+    /**
+     * Use a negotiated integer alias instead of the address string
+     *
+     * The address is sent as a 4-byte big-endian id whose first byte is
+     * zero, so the server can tell it apart from '/' and '#bundle'. The
+     * receiver must have the alias registered (see OSCAliasTable).
+     * @return true on success, false if the id is out of range
+     */
+    bool setAlias(uint32_t id)
+    {
+        if (id >= MAX_ALIASES) return false;
+
+        mAddress[0] = '\0';
+        mAddress[1] = static_cast<char>((id >> 16) & 0xFF);
+        mAddress[2] = static_cast<char>((id >> 8) & 0xFF);
+        mAddress[3] = static_cast<char>(id & 0xFF);
+        mAddressSize = 4;
+        return true;
+    }
+
+    /**
+     * Add a 32-bit integer argument
+     */
+    bool addInt(int32_t value)
+    {
+        if (!canAddArg(4)) return false;
+
+        mTypeTags[mTypeTagCount++] = 'i';
+        value = swap_endian(value);
+        std::memcpy(mArgBuffer + mArgBufferSize, &value, 4);
+        mArgBufferSize += 4;
+        return true;
+    }
+
+    /**
+     * Add a 32-bit float argument
+     */
+    bool addFloat(float value)
+    {
+        if (!canAddArg(4)) return false;
+
+        mTypeTags[mTypeTagCount++] = 'f';
+        value = swap_endian_float(value);
+        std::memcpy(mArgBuffer + mArgBufferSize, &value, 4);
+        mArgBufferSize += 4;
+        return true;
+    }
+
+    /**
+     * Add a string argument
+     */
+    bool addString(const char* value)
+    {
+        const std::size_t len = std::strlen(value);
+        const std::size_t paddedLen = ((len + 1) + 3) & ~3;  // Round up to 4-byte boundary
+
+        if (!canAddArg(paddedLen)) return false;
+
+        mTypeTags[mTypeTagCount++] = 's';
+
+        // Copy string with null terminator
+        std::memcpy(mArgBuffer + mArgBufferSize, value, len + 1);
+        mArgBufferSize += len + 1;
+
+        // Pad to 4-byte boundary
+        while (mArgBufferSize % 4 != 0) {
+            mArgBuffer[mArgBufferSize++] = '\0';
+        }
+
+        return true;
+    }
+
+    /**
+     * Add a blob (binary data) argument
+     */
+    bool addBlob(const void* data, int32_t size)
+    {
+        const std::size_t paddedDataLen = (static_cast<std::size_t>(size) + 3) & ~3;
+
+        if (!canAddArg(4 + paddedDataLen)) return false;
+
+        mTypeTags[mTypeTagCount++] = 'b';
+
+        // Write size (big-endian)
+        int32_t beSize = swap_endian(size);
+        std::memcpy(mArgBuffer + mArgBufferSize, &beSize, 4);
+        mArgBufferSize += 4;
+
+        // Write data
+        std::memcpy(mArgBuffer + mArgBufferSize, data, static_cast<std::size_t>(size));
+        mArgBufferSize += size;
+
+        // Pad to 4-byte boundary
+        while (mArgBufferSize % 4 != 0) {
+            mArgBuffer[mArgBufferSize++] = '\0';
+        }
+
+        return true;
+    }
+
+    /**
+     * Add a 64-bit integer argument
+     */
+    bool addInt64(int64_t value)
+    {
+        if (!canAddArg(8)) return false;
+
+        mTypeTags[mTypeTagCount++] = 'h';
+        value = swap_endian(value);
+        std::memcpy(mArgBuffer + mArgBufferSize, &value, 8);
+        mArgBufferSize += 8;
+        return true;
+    }
+
+    /**
+     * Add a 64-bit double argument
+     */
+    bool addDouble(double value)
+    {
+        if (!canAddArg(8)) return false;
+
+        mTypeTags[mTypeTagCount++] = 'd';
+        value = swap_endian_double(value);
+        std::memcpy(mArgBuffer + mArgBufferSize, &value, 8);
+        mArgBufferSize += 8;
+        return true;
+    }
+
+    /**
+     * Add a timetag argument
+     */
+    bool addTimetag(OSCTimetag tt)
+    {
+        if (!canAddArg(8)) return false;
+
+        mTypeTags[mTypeTagCount++] = 't';
+        tt.seconds = swap_endian(tt.seconds);
+        tt.fractions = swap_endian(tt.fractions);
+        std::memcpy(mArgBuffer + mArgBufferSize, &tt.seconds, 4);
+        std::memcpy(mArgBuffer + mArgBufferSize + 4, &tt.fractions, 4);
+        mArgBufferSize += 8;
+        return true;
+    }
+
+    /**
+     * Add a True value (no data, just type tag)
+     */
+    bool addTrue()
+    {
+        if (mTypeTagCount >= MAX_TYPE_TAG_SIZE - 1) return false;
+        mTypeTags[mTypeTagCount++] = 'T';
+        return true;
+    }
+
+    /**
+     * Add a False value (no data, just type tag)
+     */
+    bool addFalse()
+    {
+        if (mTypeTagCount >= MAX_TYPE_TAG_SIZE - 1) return false;
+        mTypeTags[mTypeTagCount++] = 'F';
+        return true;
+    }
+
+    /**
+     * Add a Nil value (no data, just type tag)
+     */
+    bool addNil()
+    {
+        if (mTypeTagCount >= MAX_TYPE_TAG_SIZE - 1) return false;
+        mTypeTags[mTypeTagCount++] = 'N';
+        return true;
+    }
+
+    /**
+     * Add an Infinitum value (no data, just type tag)
+     */
+    bool addInfinitum()
+    {
+        if (mTypeTagCount >= MAX_TYPE_TAG_SIZE - 1) return false;
+        mTypeTags[mTypeTagCount++] = 'I';
+        return true;
+    }
+
+    /**
+     * Add a MIDI message (4 bytes: port, status, data1, data2)
+     */
+    bool addMidi(uint8_t port, uint8_t status, uint8_t data1, uint8_t data2)
+    {
+        if (!canAddArg(4)) return false;
+
+        mTypeTags[mTypeTagCount++] = 'm';
+        mArgBuffer[mArgBufferSize++] = static_cast<char>(port);
+        mArgBuffer[mArgBufferSize++] = static_cast<char>(status);
+        mArgBuffer[mArgBufferSize++] = static_cast<char>(data1);
+        mArgBuffer[mArgBufferSize++] = static_cast<char>(data2);
+        return true;
+    }
+
+    /**
+     * Add a character argument
+     */
+    bool addChar(char c)
+    {
+        if (!canAddArg(4)) return false;
+
+        mTypeTags[mTypeTagCount++] = 'c';
+        // Character is stored as a 32-bit value (big-endian, char in last byte)
+        mArgBuffer[mArgBufferSize++] = '\0';
+        mArgBuffer[mArgBufferSize++] = '\0';
+        mArgBuffer[mArgBufferSize++] = '\0';
+        mArgBuffer[mArgBufferSize++] = c;
+        return true;
+    }
+
+    /**
+     * Add an RGBA color argument
+     */
+    bool addColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+    {
+        if (!canAddArg(4)) return false;
+
+        mTypeTags[mTypeTagCount++] = 'r';
+        mArgBuffer[mArgBufferSize++] = static_cast<char>(r);
+        mArgBuffer[mArgBufferSize++] = static_cast<char>(g);
+        mArgBuffer[mArgBufferSize++] = static_cast<char>(b);
+        mArgBuffer[mArgBufferSize++] = static_cast<char>(a);
+        return true;
+    }
+
+    /**
+     * Build the complete OSC message into the provided buffer
+     * @param outBuffer Buffer to write to
+     * @param maxSize Maximum size of the buffer
+     * @return Number of bytes written, or 0 on error
+     */
+    std::size_t build(char* outBuffer, std::size_t maxSize) const
+    {
+        // Calculate total size needed
+        const std::size_t typeTagSize = 1 + mTypeTagCount + 1;  // comma + tags + null
+        const std::size_t typeTagPadded = (typeTagSize + 3) & ~3;
+        const std::size_t totalSize = mAddressSize + typeTagPadded + mArgBufferSize;
+
+        if (totalSize > maxSize || mAddressSize == 0) {
+            return 0;
+        }
+
+        std::size_t pos = 0;
+
+        // Write address
+        std::memcpy(outBuffer + pos, mAddress, mAddressSize);
+        pos += mAddressSize;
+
+        // Write type tag string: comma + types + null + padding
+        outBuffer[pos++] = ',';
+        std::memcpy(outBuffer + pos, mTypeTags, mTypeTagCount);
+        pos += mTypeTagCount;
+        outBuffer[pos++] = '\0';
+        while (pos % 4 != 0) {
+            outBuffer[pos++] = '\0';
+        }
+
+        // Write arguments
+        std::memcpy(outBuffer + pos, mArgBuffer, mArgBufferSize);
+        pos += mArgBufferSize;
+
+        return pos;
+    }
+
+    /**
+     * Send the message using an OSCClient
+     * @return true on success, false on failure
+     */
+    bool send(OSCClient& client) const
+    {
+        char buffer[MAX_MESSAGE_SIZE];
+        const std::size_t size = build(buffer, MAX_MESSAGE_SIZE);
+        if (size == 0) {
+            return false;
+        }
+        return client.send(buffer, static_cast<uint16_t>(size));
+    }
+
+    /**
+     * Build the message once and send it to every destination in a group
+     * @return true if sent to all destinations
+     */
+    bool send(OSCClientGroup& group) const
+    {
+        char buffer[MAX_MESSAGE_SIZE];
+        const std::size_t size = build(buffer, MAX_MESSAGE_SIZE);
+        if (size == 0) {
+            return false;
+        }
+        return group.send(buffer, static_cast<uint16_t>(size));
+    }
+
+    /**
+     * Build the message and queue it for a rate-limited send
+     * @return true on success, false on failure
+     */
+    bool send(OSCSendQueue& queue) const
+    {
+        char buffer[MAX_MESSAGE_SIZE];
+        const std::size_t size = build(buffer, MAX_MESSAGE_SIZE);
+        if (size == 0) {
+            return false;
+        }
+        return queue.send(buffer, static_cast<uint16_t>(size));
+    }
+
+#if LWIP_TCP
+    /**
+     * Send the message over a TCP stream
+     * @return true on success, false on failure
+     */
+    bool send(OSCTcpClient& client) const
+    {
+        char buffer[MAX_MESSAGE_SIZE];
+        const std::size_t size = build(buffer, MAX_MESSAGE_SIZE);
+        if (size == 0) {
+            return false;
+        }
+        return client.send(buffer, static_cast<uint16_t>(size));
+    }
+#endif
+
+    // Accessors for debugging
+    std::size_t addressSize() const { return mAddressSize; }
+    std::size_t typeTagCount() const { return mTypeTagCount; }
+    std::size_t argBufferSize() const { return mArgBufferSize; }
+
+private:
+    bool canAddArg(std::size_t bytes) const
+    {
+        return (mTypeTagCount < MAX_TYPE_TAG_SIZE - 1) &&
+               (mArgBufferSize + bytes <= MAX_ARG_BUFFER_SIZE);
+    }
+
+    char mAddress[MAX_ADDRESS_SIZE];
+    std::size_t mAddressSize = 0;
+
+    char mTypeTags[MAX_TYPE_TAG_SIZE];
+    std::size_t mTypeTagCount = 0;
+
+    char mArgBuffer[MAX_ARG_BUFFER_SIZE];
+    std::size_t mArgBufferSize = 0;
+};
+
+/**
+ * OSC Bundle builder
+ * 
+ * A bundle contains a timetag and multiple messages.
+ * Bundles can be nested (bundles containing bundles).
+ */
+class OSCBundle
+{
+public:
+    static constexpr std::size_t MAX_BUNDLE_SIZE = 4096;
+
+    OSCBundle() { clear(); }
+
+    void clear()
+    {
+        mBufferSize = 0;
+        std::memset(mBuffer, 0, MAX_BUNDLE_SIZE);
+
+        // Write bundle header "#bundle\0"
+        static const char header[] = "#bundle";
+        std::memcpy(mBuffer, header, 8);
+        mBufferSize = 8;
+
+        // Reserve space for timetag (will be set later)
+        mBufferSize += 8;
+    }
+
+    /**
+     * Set the bundle timetag
+     */
+    void setTimetag(OSCTimetag tt)
+    {
+        uint32_t seconds = swap_endian(tt.seconds);
+        uint32_t fractions = swap_endian(tt.fractions);
+        std::memcpy(mBuffer + 8, &seconds, 4);
+        std::memcpy(mBuffer + 12, &fractions, 4);
+    }
+
+    /**
+     * Add a message to the bundle
+     * @param limit Keep the bundle at or below this size (e.g. an MTU)
+     * @return true on success, false if bundle is full
+     */
+    bool addMessage(const OSCMessage& msg, std::size_t limit = MAX_BUNDLE_SIZE)
+    {
+        char msgBuffer[MAX_MESSAGE_SIZE];
+        const std::size_t msgSize = msg.build(msgBuffer, sizeof(msgBuffer));
+        if (msgSize == 0) {
+            return false;
+        }
+
+        // Check if we have space (4 bytes for size + message)
+        if (mBufferSize + 4 + msgSize > (limit < MAX_BUNDLE_SIZE ? limit : MAX_BUNDLE_SIZE)) {
+            return false;
+        }
+
+        // Write message size (big-endian)
+        int32_t beSize = swap_endian(static_cast<int32_t>(msgSize));
+        std::memcpy(mBuffer + mBufferSize, &beSize, 4);
+        mBufferSize += 4;
+
+        // Write message content
+        std::memcpy(mBuffer + mBufferSize, msgBuffer, msgSize);
+        mBufferSize += msgSize;
+
+        return true;
+    }
+
+    /**
+     * Overwrite a 32-bit argument of a message already in the bundle
+     * Lets a field be decided after the rest of the bundle was built (e.g.
+     * a flag in a header message); take the offset from size() right after
+     * adding the message.
+     * @param offset Byte offset of the argument from the start of the bundle
+     * @return false if the argument would not lie inside the bundle
+     */
+    bool patchInt(std::size_t offset, int32_t value)
+    {
+        if (offset < 16 || offset > mBufferSize || mBufferSize - offset < 4) return false;
+        const int32_t be = swap_endian(value);
+        std::memcpy(mBuffer + offset, &be, 4);
+        return true;
+    }
+
+    /**
+     * True if no messages have been added since clear()
+     */
+    bool empty() const { return mBufferSize == 16; }
+
+    /**
+     * Get the bundle data
+     */
+    const char* data() const { return mBuffer; }
+
+    /**
+     * Get the bundle size
+     */
+    std::size_t size() const { return mBufferSize; }
+
+    /**
+     * Send the bundle using an OSCClient
+     */
+    bool send(OSCClient& client) const
+    {
+        return client.send(mBuffer, static_cast<uint16_t>(mBufferSize));
+    }
+
+    /**
+     * Send the bundle to every destination in a group
+     */
+    bool send(OSCClientGroup& group) const
+    {
+        return group.send(mBuffer, static_cast<uint16_t>(mBufferSize));
+    }
+
+#if LWIP_TCP
+    /**
+     * Send the bundle over a TCP stream
+     */
+    bool send(OSCTcpClient& client) const
+    {
+        return client.send(mBuffer, static_cast<uint16_t>(mBufferSize));
+    }
+#endif
+
+private:
+    char mBuffer[MAX_BUNDLE_SIZE];
+    std::size_t mBufferSize = 0;
+
+    static constexpr std::size_t MAX_MESSAGE_SIZE = 1024;
+};
+
+/**
+ * Integer aliases for OSC addresses
+ *
+ * Senders register an alias once with a "/alias" message carrying
+ * (int32 id, string address) pairs and then send messages with
+ * OSCMessage::setAlias(id). The server resolves the id by indexing this
+ * table, so aliased messages skip address string matching entirely.
+ * For a single float the packet shrinks from ~32 to 12 bytes.
+ *
+ * The same class is used on both sides: the sender fills it and calls
+ * announce(), the server attaches it with setAliasTable(). Announcements
+ * are idempotent; re-send them periodically since UDP can drop them.
+ */
+class OSCAliasTable
+{
+public:
+    static constexpr const char* ALIAS_ADDRESS = "/alias";
+
+    OSCAliasTable() { clear(); }
+
+    void clear()
+    {
+        for (auto& address : mAddresses) address[0] = '\0';
+    }
+
+    /**
+     * Register an address under an id
+     * @return false if the id is out of range or the address does not fit
+     */
+    bool set(uint32_t id, const char* address)
+    {
+        if (id >= MAX_ALIASES || !address || address[0] != '/') return false;
+        const std::size_t len = std::strlen(address);
+        if (len >= MAX_ALIAS_ADDRESS_SIZE) return false;
+        std::memcpy(mAddresses[id], address, len + 1);
+        return true;
+    }
+
+    bool remove(uint32_t id)
+    {
+        if (id >= MAX_ALIASES) return false;
+        mAddresses[id][0] = '\0';
+        return true;
+    }
+
+    /**
+     * Id of an aliased address: 24-bit big-endian after a zero byte
+     */
+    static uint32_t wireId(const char* address)
+    {
+        return (static_cast<uint32_t>(static_cast<uint8_t>(address[1])) << 16) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(address[2])) << 8) |
+               static_cast<uint32_t>(static_cast<uint8_t>(address[3]));
+    }
+
+    /**
+     * @return The address for an id, or nullptr if it is not registered
+     */
+    const char* resolve(uint32_t id) const
+    {
+        return (id < MAX_ALIASES && mAddresses[id][0] != '\0') ? mAddresses[id] : nullptr;
+    }
+
+    /**
+     * Send every registered alias as a "/alias" message
+     * @return true if all announcements were sent
+     */
+    bool announce(OSCClient& client) const
+    {
+        bool ok = true;
+        OSCMessage msg;
+        for (uint32_t id = 0; id < MAX_ALIASES; id++) {
+            if (mAddresses[id][0] == '\0') continue;
+            msg.clear();
+            msg.setAddress(ALIAS_ADDRESS);
+            msg.addInt(static_cast<int32_t>(id));
+            msg.addString(mAddresses[id]);
+            ok = msg.send(client) && ok;
+        }
+        return ok;
+    }
+
+private:
+    char mAddresses[MAX_ALIASES][MAX_ALIAS_ADDRESS_SIZE];
+};
+
+/**
+ * Blob argument for typed handlers (points into the received packet)
+ */
+struct OSCBlob
+{
+    const uint8_t* data;
+    int32_t size;
+};
+
+/**
+ * Type tag and raw decoder for each argument type a typed handler accepts
+ *
+ * read() decodes one argument at p and advances it; it only checks that
+ * the argument fits, since the type tags were already compared.
+ */
+template<typename T>
+struct OSCArgTraits;
+
+template<>
+struct OSCArgTraits<int32_t>
+{
+    static constexpr char tag = 'i';
+    static bool read(const char*& p, const char* end, int32_t& out)
+    {
+        if (end - p < 4) return false;
+        std::memcpy(&out, p, 4);
+        out = swap_endian(out);
+        p += 4;
+        return true;
+    }
+};
+
+template<>
+struct OSCArgTraits<float>
+{
+    static constexpr char tag = 'f';
+    static bool read(const char*& p, const char* end, float& out)
+    {
+        if (end - p < 4) return false;
+        std::memcpy(&out, p, 4);
+        out = swap_endian_float(out);
+        p += 4;
+        return true;
+    }
+};
+
+template<>
+struct OSCArgTraits<int64_t>
+{
+    static constexpr char tag = 'h';
+    static bool read(const char*& p, const char* end, int64_t& out)
+    {
+        if (end - p < 8) return false;
+        std::memcpy(&out, p, 8);
+        out = swap_endian(out);
+        p += 8;
+        return true;
+    }
+};
+
+template<>
+struct OSCArgTraits<double>
+{
+    static constexpr char tag = 'd';
+    static bool read(const char*& p, const char* end, double& out)
+    {
+        if (end - p < 8) return false;
+        std::memcpy(&out, p, 8);
+        out = swap_endian_double(out);
+        p += 8;
+        return true;
+    }
+};
+
+template<>
+struct OSCArgTraits<OSCTimetag>
+{
+    static constexpr char tag = 't';
+    static bool read(const char*& p, const char* end, OSCTimetag& out)
+    {
+        if (end - p < 8) return false;
+        std::memcpy(&out.seconds, p, 4);
+        std::memcpy(&out.fractions, p + 4, 4);
+        out.seconds = swap_endian(out.seconds);
+        out.fractions = swap_endian(out.fractions);
+        p += 8;
+        return true;
+    }
+};
+
+template<>
+struct OSCArgTraits<char>
+{
+    static constexpr char tag = 'c';
+    static bool read(const char*& p, const char* end, char& out)
+    {
+        if (end - p < 4) return false;
+        out = p[3];
+        p += 4;
+        return true;
+    }
+};
+
+template<>
+struct OSCArgTraits<const char*>
+{
+    static constexpr char tag = 's';
+    static bool read(const char*& p, const char* end, const char*& out)
+    {
+        const void* nul = std::memchr(p, '\0', static_cast<std::size_t>(end - p));
+        if (!nul) return false;
+        out = p;
+        const std::size_t len = static_cast<std::size_t>(static_cast<const char*>(nul) - p) + 1;
+        const std::size_t padded = (len + 3) & ~static_cast<std::size_t>(3);
+        const std::size_t skip = (padded <= static_cast<std::size_t>(end - p)) ? padded : len;
+        for (std::size_t i = len; i < skip; i++) {
+            if (p[i] != '\0') return false;  // Padding must be zero, as in OSCMessageView::parse()
+        }
+        p += skip;
+        return true;
+    }
+};
+
+template<>
+struct OSCArgTraits<OSCBlob>
+{
+    static constexpr char tag = 'b';
+    static bool read(const char*& p, const char* end, OSCBlob& out)
+    {
+        if (end - p < 4) return false;
+        std::memcpy(&out.size, p, 4);
+        out.size = swap_endian(out.size);
+        p += 4;
+        if (out.size < 0 || out.size > end - p) return false;
+        out.data = reinterpret_cast<const uint8_t*>(p);
+        const std::size_t padded = (static_cast<std::size_t>(out.size) + 3) & ~static_cast<std::size_t>(3);
+        p += (padded <= static_cast<std::size_t>(end - p)) ? padded : static_cast<std::size_t>(out.size);
+        return true;
+    }
+};
+
+/**
+ * Type tag string for a handler signature, built at compile time
+ * e.g. OSCTypeSignature<float, int32_t>::tags == "fi"
+ */
+template<typename... Args>
+struct OSCTypeSignature
+{
+    static constexpr char tags[] = {OSCArgTraits<std::decay_t<Args>>::tag..., '\0'};
+    static constexpr std::size_t size = sizeof...(Args);
+};
+
+/**
+ * Decode the arguments for a signature straight into a tuple
+ * @return false if an argument runs past the end of the packet
+ */
+template<typename... Args, std::size_t... I>
+bool decodeOSCArgs(const char* p, const char* end, std::tuple<Args...>& out, std::index_sequence<I...>)
+{
+    (void)p;
+    (void)end;
+    return (OSCArgTraits<Args>::read(p, end, std::get<I>(out)) && ...);
+}
+
+/**
+ * Parsed OSC argument
+ */
+struct OSCArg
+{
+    char type;
+    union {
+        int32_t i;
+        float f;
+        int64_t h;
+        double d;
+        OSCTimetag t;
+        struct { uint8_t port, status, data1, data2; } midi;
+        struct { uint8_t r, g, b, a; } color;
+        char c;
+    };
+    const char* s;           // For strings (points into original buffer)
+    const uint8_t* blobData; // For blobs (points into original buffer)
+    int32_t blobSize;        // For blobs
+};
+
+/**
+ * Maps a type tag to its numeric kind (0 = not numeric)
+ */
+struct OSCArgKindTable
+{
+    uint8_t kind[128];
+};
+
+constexpr OSCArgKindTable makeOSCArgKindTable()
+{
+    OSCArgKindTable table = {};
+    table.kind[static_cast<unsigned char>('i')] = 1;
+    table.kind[static_cast<unsigned char>('f')] = 2;
+    table.kind[static_cast<unsigned char>('h')] = 3;
+    table.kind[static_cast<unsigned char>('d')] = 4;
+    table.kind[static_cast<unsigned char>('T')] = 5;
+    table.kind[static_cast<unsigned char>('F')] = 6;
+    table.kind[static_cast<unsigned char>('c')] = 7;
+    return table;
+}
+
+/**
+ * Argument coercion behind the OSCMessageView accessors
+ *
+ * The exact type is read directly by each accessor; any other type goes
+ * through one table load and one indirect call instead of a switch. Each
+ * target type has its own table, so e.g. getFloat() on an 'i' is a single
+ * int-to-float conversion and never touches double (soft-float on M0+).
+ * Float to int truncates and saturates, int64 to int32 saturates,
+ * True/False read as 1/0, and 'c' as its character code.
+ */
+struct OSCCoercion
+{
+    template<typename T>
+    using Converter = T (*)(const OSCArg& arg);
+
+    /**
+     * @return Converter to T for a type tag, or nullptr if not numeric
+     */
+    template<typename T>
+    static Converter<T> to(char type)
+    {
+        const unsigned char index = static_cast<unsigned char>(type);
+        return (index < 128) ? Table<T>::CONVERTERS[KINDS.kind[index]] : nullptr;
+    }
+
+    /**
+     * Convert between numeric types, saturating when narrowing to an integer
+     */
+    template<typename T, typename V>
+    static T saturate(V value)
+    {
+        if constexpr (std::is_integral<T>::value && std::is_floating_point<V>::value) {
+            if (!(value == value)) return 0;  // NaN
+            if (value >= static_cast<V>(std::numeric_limits<T>::max())) return std::numeric_limits<T>::max();
+            if (value <= static_cast<V>(std::numeric_limits<T>::min())) return std::numeric_limits<T>::min();
+            return static_cast<T>(value);
+        } else if constexpr (std::is_integral<T>::value && sizeof(V) > sizeof(T)) {
+            if (value > std::numeric_limits<T>::max()) return std::numeric_limits<T>::max();
+            if (value < std::numeric_limits<T>::min()) return std::numeric_limits<T>::min();
+            return static_cast<T>(value);
+        } else {
+            return static_cast<T>(value);
+        }
+    }
+
+private:
+    template<typename T>
+    struct Table
+    {
+        static T fromInt32(const OSCArg& arg) { return saturate<T>(arg.i); }
+        static T fromFloat(const OSCArg& arg) { return saturate<T>(arg.f); }
+        static T fromInt64(const OSCArg& arg) { return saturate<T>(arg.h); }
+        static T fromDouble(const OSCArg& arg) { return saturate<T>(arg.d); }
+        static T fromTrue(const OSCArg&) { return static_cast<T>(1); }
+        static T fromFalse(const OSCArg&) { return static_cast<T>(0); }
+        static T fromChar(const OSCArg& arg) { return static_cast<T>(static_cast<unsigned char>(arg.c)); }
+
+        static constexpr Converter<T> CONVERTERS[8] = {
+            nullptr, &fromInt32, &fromFloat, &fromInt64, &fromDouble, &fromTrue, &fromFalse, &fromChar,
+        };
+    };
+
+    static constexpr OSCArgKindTable KINDS = makeOSCArgKindTable();
+};
+
+/**
+ * Parsed OSC message (read-only view into received data)
+ */
+class OSCMessageView
+{
+public:
+    OSCMessageView() { clear(); }
+
+    void clear()
+    {
+        mAddress = nullptr;
+        mTypeTags = nullptr;
+        mArgCount = 0;
+        mAlias = -1;
+        mTimetag = OSCTimetag::immediate();
+        mError = OSCParseError::None;
+    }
+
+    /**
+     * Reject anything the OSC 1.0 spec does not allow
+     * Lenient parsing (the default) skips unknown type tags, ignores blob
+     * padding and trailing bytes, and stops at MAX_ARGS arguments. Strict
+     * parsing fails on all of them. It stays set across parse() calls.
+     */
+    void setStrict(bool strict) { mStrict = strict; }
+    bool strict() const { return mStrict; }
+
+    /**
+     * Parse an OSC message from a buffer
+     * @param aliases Resolves integer-aliased addresses (optional)
+     * @return true if valid OSC message, false otherwise
+     */
+    bool parse(const char* buffer, std::size_t size, const OSCAliasTable* aliases = nullptr)
+    {
+        PICOOSC_TRACE_SCOPE(OSCTraceEvent::Parse, size);
+        clear();
+        if (size < 4) return fail(OSCParseError::InvalidAddress);
+        const bool strict = mStrict;  // Kept in a register across the argument stores
+        if (strict && (size & 3) != 0) return fail(OSCParseError::TrailingData);
+
         std::size_t pos = 0;
 
-        // Parse address
-        mAddress = buffer;
-        while (pos < size && buffer[pos] != '\0') pos++;
-        if (pos >= size) return false;
-        pos++;  // Skip null
-        pos = (pos + 3) & ~3;  // Align to 4 bytes
+        if (buffer[0] == '\0' && aliases) {
+            const uint32_t id = OSCAliasTable::wireId(buffer);
+            mAddress = aliases->resolve(id);
+            if (!mAddress) return fail(OSCParseError::UnknownAlias);
+            mAlias = static_cast<int32_t>(id);
+            pos = 4;
+        } else {
+            if (buffer[0] != '/') return fail(OSCParseError::InvalidAddress);  // Must start with '/'
+
+            // Parse address
+            mAddress = buffer;
+            if (!skipString(buffer, size, pos, OSCParseError::UnterminatedAddress)) return false;
+        }
+
+        // Parse type tag string
+        if (pos >= size || buffer[pos] != ',') {
+            // No type tags = no arguments (valid)
+            mTypeTags = "";
+            return !strict || pos == size || fail(OSCParseError::TrailingData);
+        }
+
+        mTypeTags = buffer + pos + 1;  // Skip comma
+        if (!skipString(buffer, size, pos, OSCParseError::UnterminatedTypeTags)) return false;
+
+        // Parse arguments based on type tags
+        const char* types = mTypeTags;
+        while (*types && mArgCount < MAX_ARGS) {
+            OSCArg& arg = mArgs[mArgCount];
+            arg.type = *types;
+            arg.s = nullptr;
+            arg.blobData = nullptr;
+
+            switch (*types) {
+                case 'i':  // int32
+                    if (pos + 4 > size) return fail(OSCParseError::TruncatedArgument);
+                    std::memcpy(&arg.i, buffer + pos, 4);
+                    arg.i = swap_endian(arg.i);
+                    pos += 4;
+                    break;
+
+                case 'f':  // float32
+                    if (pos + 4 > size) return fail(OSCParseError::TruncatedArgument);
+                    std::memcpy(&arg.f, buffer + pos, 4);
+                    arg.f = swap_endian_float(arg.f);
+                    pos += 4;
+                    break;
+
+                case 's':  // string
+                case 'S':  // symbol (treated same as string)
+                    arg.s = buffer + pos;
+                    if (!skipString(buffer, size, pos, OSCParseError::UnterminatedString)) return false;
+                    break;
+
+                case 'b':  // blob
+                    if (pos + 4 > size) return fail(OSCParseError::TruncatedArgument);
+                    std::memcpy(&arg.blobSize, buffer + pos, 4);
+                    arg.blobSize = swap_endian(arg.blobSize);
+                    pos += 4;
+                    if (arg.blobSize < 0 || static_cast<std::size_t>(arg.blobSize) > size - pos) {
+                        return fail(OSCParseError::InvalidBlobSize);
+                    }
+                    arg.blobData = reinterpret_cast<const uint8_t*>(buffer + pos);
+                    pos += static_cast<std::size_t>(arg.blobSize);
+                    if (strict) {
+                        for (; (pos & 3) != 0 && pos < size; pos++) {
+                            if (buffer[pos] != '\0') return fail(OSCParseError::InvalidPadding);
+                        }
+                    }
+                    pos = (pos + 3) & ~3;
+                    break;
+
+                case 'h':  // int64
+                    if (pos + 8 > size) return fail(OSCParseError::TruncatedArgument);
+                    std::memcpy(&arg.h, buffer + pos, 8);
+                    arg.h = swap_endian(arg.h);
+                    pos += 8;
+                    break;
+
+                case 'd':  // double
+                    if (pos + 8 > size) return fail(OSCParseError::TruncatedArgument);
+                    std::memcpy(&arg.d, buffer + pos, 8);
+                    arg.d = swap_endian_double(arg.d);
+                    pos += 8;
+                    break;
+
+                case 't':  // timetag
+                    if (pos + 8 > size) return fail(OSCParseError::TruncatedArgument);
+                    std::memcpy(&arg.t.seconds, buffer + pos, 4);
+                    std::memcpy(&arg.t.fractions, buffer + pos + 4, 4);
+                    arg.t.seconds = swap_endian(arg.t.seconds);
+                    arg.t.fractions = swap_endian(arg.t.fractions);
+                    pos += 8;
+                    break;
+
+                case 'm':  // MIDI
+                    if (pos + 4 > size) return fail(OSCParseError::TruncatedArgument);
+                    arg.midi.port = static_cast<uint8_t>(buffer[pos]);
+                    arg.midi.status = static_cast<uint8_t>(buffer[pos + 1]);
+                    arg.midi.data1 = static_cast<uint8_t>(buffer[pos + 2]);
+                    arg.midi.data2 = static_cast<uint8_t>(buffer[pos + 3]);
+                    pos += 4;
+                    break;
+
+                case 'c':  // char (stored as int32)
+                    if (pos + 4 > size) return fail(OSCParseError::TruncatedArgument);
+                    arg.c = buffer[pos + 3];  // Last byte
+                    pos += 4;
+                    break;
+
+                case 'r':  // RGBA color
+                    if (pos + 4 > size) return fail(OSCParseError::TruncatedArgument);
+                    arg.color.r = static_cast<uint8_t>(buffer[pos]);
+                    arg.color.g = static_cast<uint8_t>(buffer[pos + 1]);
+                    arg.color.b = static_cast<uint8_t>(buffer[pos + 2]);
+                    arg.color.a = static_cast<uint8_t>(buffer[pos + 3]);
+                    pos += 4;
+                    break;
+
+                case 'T':  // True
+                case 'F':  // False
+                case 'N':  // Nil
+                case 'I':  // Infinitum
+                case '[':  // Array begin
+                case ']':  // Array end
+                    // No data bytes
+                    break;
+
+                default:
+                    // Unknown type, skip
+                    if (strict) return fail(OSCParseError::UnknownTypeTag);
+                    break;
+            }
+
+            mArgCount++;
+            types++;
+        }
+
+        if (strict) {
+            if (*types) return fail(OSCParseError::TooManyArguments);
+            if (pos != size) return fail(OSCParseError::TrailingData);
+        }
+        return true;
+    }
+
+    /**
+     * Why the last parse() failed (None after a successful parse)
+     */
+    OSCParseError error() const { return mError; }
+
+    const char* address() const { return mAddress; }
+
+    /**
+     * Alias id the message was sent with, or -1 for a plain address
+     */
+    int32_t alias() const { return mAlias; }
+
+    /**
+     * When the message is due: the effective timetag of the innermost
+     * bundle holding it, or immediate for a message sent on its own
+     * Set by the dispatcher after parse().
+     */
+    OSCTimetag timetag() const { return mTimetag; }
+    void setTimetag(OSCTimetag timetag) { mTimetag = timetag; }
+    const char* typeTags() const { return mTypeTags; }
+    std::size_t argCount() const { return mArgCount; }
+
+    const OSCArg* arg(std::size_t index) const
+    {
+        return (index < mArgCount) ? &mArgs[index] : nullptr;
+    }
+
+    // Convenience accessors. Numeric types are coerced (see OSCCoercion);
+    // the default is returned if the argument is missing or not numeric.
+    int32_t getInt(std::size_t index, int32_t defaultVal = 0) const
+    {
+        const OSCArg* a = arg(index);
+        if (!a) return defaultVal;
+        if (a->type == 'i') return a->i;
+        const OSCCoercion::Converter<int32_t> convert = OSCCoercion::to<int32_t>(a->type);
+        return convert ? convert(*a) : defaultVal;
+    }
+
+    float getFloat(std::size_t index, float defaultVal = 0.0f) const
+    {
+        const OSCArg* a = arg(index);
+        if (!a) return defaultVal;
+        if (a->type == 'f') return a->f;
+        const OSCCoercion::Converter<float> convert = OSCCoercion::to<float>(a->type);
+        return convert ? convert(*a) : defaultVal;
+    }
+
+    int64_t getInt64(std::size_t index, int64_t defaultVal = 0) const
+    {
+        const OSCArg* a = arg(index);
+        if (!a) return defaultVal;
+        if (a->type == 'h') return a->h;
+        if (a->type == 'i') return a->i;
+        const OSCCoercion::Converter<int64_t> convert = OSCCoercion::to<int64_t>(a->type);
+        return convert ? convert(*a) : defaultVal;
+    }
+
+    double getDouble(std::size_t index, double defaultVal = 0.0) const
+    {
+        const OSCArg* a = arg(index);
+        if (!a) return defaultVal;
+        if (a->type == 'd') return a->d;
+        const OSCCoercion::Converter<double> convert = OSCCoercion::to<double>(a->type);
+        return convert ? convert(*a) : defaultVal;
+    }
+
+    /**
+     * String or symbol argument
+     */
+    const char* getString(std::size_t index, const char* defaultVal = "") const
+    {
+        const OSCArg* a = arg(index);
+        return (a && (a->type == 's' || a->type == 'S') && a->s) ? a->s : defaultVal;
+    }
+
+    /**
+     * True/False argument, or a number compared against zero
+     */
+    bool getBool(std::size_t index, bool defaultVal = false) const
+    {
+        const OSCArg* a = arg(index);
+        if (!a) return defaultVal;
+        if (a->type == 'T') return true;
+        if (a->type == 'F') return false;
+        if (a->type == 'f') return a->f != 0.0f;
+        if (a->type == 'd') return a->d != 0.0;
+        const OSCCoercion::Converter<int64_t> convert = OSCCoercion::to<int64_t>(a->type);
+        return convert ? convert(*a) != 0 : defaultVal;
+    }
+
+    /**
+     * Check if address matches a pattern
+     * Supports basic wildcard: * matches any sequence, ? matches single char
+     */
+    bool matchAddress(const char* pattern) const
+    {
+        if (!mAddress || !pattern) return false;
+        return matchPattern(pattern, mAddress);
+    }
+
+private:
+    static constexpr std::size_t MAX_ARGS = 64;
+
+    bool fail(OSCParseError error)
+    {
+        mError = error;
+        return false;
+    }
+
+    // Move pos past a string and its padding, which must be zero
+    bool skipString(const char* buffer, std::size_t size, std::size_t& pos, OSCParseError unterminated)
+    {
+        if (pos >= size) return fail(unterminated);
+        const std::size_t nul = pos + findOSCTerminator(buffer + pos, size - pos);
+        if (nul >= size) return fail(unterminated);
+        const std::size_t next = (nul + 4) & ~static_cast<std::size_t>(3);
+        for (std::size_t i = nul + 1; i < next && i < size; i++) {
+            if (buffer[i] != '\0') return fail(OSCParseError::InvalidPadding);
+        }
+        pos = next;
+        return true;
+    }
+
+    static bool matchPattern(const char* pattern, const char* str)
+    {
+        while (*pattern && *str) {
+            if (*pattern == '*') {
+                pattern++;
+                if (!*pattern) return true;
+                while (*str) {
+                    if (matchPattern(pattern, str)) return true;
+                    str++;
+                }
+                return false;
+            } else if (*pattern == '?' || *pattern == *str) {
+                pattern++;
+                str++;
+            } else {
+                return false;
+            }
+        }
+        while (*pattern == '*') pattern++;
+        return !*pattern && !*str;
+    }
+
+    const char* mAddress = nullptr;
+    const char* mTypeTags = nullptr;
+    OSCArg mArgs[MAX_ARGS];
+    std::size_t mArgCount = 0;
+    int32_t mAlias = -1;
+    OSCTimetag mTimetag = OSCTimetag::immediate();
+    OSCParseError mError = OSCParseError::None;
+    bool mStrict = false;
+};
+
+/**
+ * True if the data starts with the bundle marker "#bundle\0"
+ * The one test used by the dispatcher, the bundle walker and
+ * validateOSCPacket(), so they agree on what is a bundle.
+ */
+inline bool isOSCBundle(const char* data, std::size_t size)
+{
+    return size >= 8 && std::memcmp(data, "#bundle", 8) == 0;
+}
+
+/**
+ * Open bundle while walking a packet
+ */
+struct OSCBundleFrame
+{
+    const char* end;
+    OSCTimetag timetag;  // Effective: inherited or clamped from the parent
+};
+
+/**
+ * Effective timetag of a bundle nested in parent
+ * An immediate bundle inherits its parent's time. A bundle scheduled
+ * before its parent breaks the OSC nesting rule and is raised to it.
+ * @param clamped Set when the rule was broken
+ */
+inline OSCTimetag effectiveTimetag(OSCTimetag timetag, const OSCBundleFrame* parent, bool& clamped)
+{
+    clamped = false;
+    if (!parent) return timetag;
+    if (timetag.isImmediate()) return parent->timetag;
+    if (!parent->timetag.isImmediate() && timetag.raw() < parent->timetag.raw()) {
+        clamped = true;
+        return parent->timetag;
+    }
+    return timetag;
+}
+
+/**
+ * Read the timetag of the bundle at pos (at least 16 bytes)
+ */
+inline OSCTimetag readBundleTimetag(const char* pos)
+{
+    OSCTimetag timetag;
+    std::memcpy(&timetag.seconds, pos + 8, 4);
+    std::memcpy(&timetag.fractions, pos + 12, 4);
+    timetag.seconds = swap_endian(timetag.seconds);
+    timetag.fractions = swap_endian(timetag.fractions);
+    return timetag;
+}
+
+/**
+ * Validate a whole packet in strict mode without dispatching it
+ * Bundles are walked with an explicit stack of MAX_BUNDLE_DEPTH ends, not
+ * recursion, and every message is parsed with a single strict view, so
+ * stack use is fixed whatever the input.
+ * @return OSCParseError::None if the packet is valid
+ */
+inline OSCParseError validateOSCPacket(const char* buffer, std::size_t size,
+                                       const OSCAliasTable* aliases = nullptr)
+{
+    OSCMessageView msg;
+    msg.setStrict(true);
+
+    OSCBundleFrame frames[MAX_BUNDLE_DEPTH];
+    std::size_t depth = 0;
+    const char* pos = buffer;
+    const char* end = buffer + size;  // End of the current element
+
+    while (true) {
+        if (isOSCBundle(pos, static_cast<std::size_t>(end - pos))) {
+            if (end - pos < 16 || ((end - pos) & 3) != 0) return OSCParseError::InvalidBundleElement;
+            if (depth == MAX_BUNDLE_DEPTH) return OSCParseError::BundleTooDeep;
+            bool clamped;
+            const OSCTimetag timetag =
+                effectiveTimetag(readBundleTimetag(pos), depth > 0 ? &frames[depth - 1] : nullptr, clamped);
+            if (clamped) return OSCParseError::TimetagOrder;
+            frames[depth++] = OSCBundleFrame{end, timetag};
+            pos += 16;  // "#bundle\0" and timetag
+        } else {
+            if (!msg.parse(pos, static_cast<std::size_t>(end - pos), aliases)) return msg.error();
+            pos = end;
+        }
+
+        // Close finished bundles, then read the size of the next element
+        while (depth > 0 && pos == frames[depth - 1].end) depth--;
+        if (depth == 0) return OSCParseError::None;
+        end = frames[depth - 1].end;
+        if (end - pos < 4) return OSCParseError::InvalidBundleElement;
+        int32_t elemSize;
+        std::memcpy(&elemSize, pos, 4);
+        elemSize = swap_endian(elemSize);
+        pos += 4;
+        if (elemSize <= 0 || (elemSize & 3) != 0 || elemSize > end - pos) {
+            return OSCParseError::InvalidBundleElement;
+        }
+        end = pos + elemSize;
+    }
+}
+
+/**
+ * Addresses used by OSCStateSender / OSCStateReceiver
+ */
+static constexpr const char* SYNC_ADDRESS = "/sync";
+static constexpr const char* SYNC_RESYNC_ADDRESS = "/sync/resync";
+
+/**
+ * Bits of the "/sync" header's flags argument
+ */
+enum class OSCSyncFlags : int32_t
+{
+    None = 0,
+    SnapshotBegin = 1,  // First bundle of a full snapshot
+    SnapshotEnd = 2,    // Last bundle of a full snapshot
+};
+
+constexpr OSCSyncFlags operator|(OSCSyncFlags a, OSCSyncFlags b)
+{
+    return static_cast<OSCSyncFlags>(static_cast<int32_t>(a) | static_cast<int32_t>(b));
+}
+
+constexpr bool hasSyncFlag(int32_t flags, OSCSyncFlags flag)
+{
+    return (flags & static_cast<int32_t>(flag)) != 0;
+}
+
+/**
+ * Delta-encoded parameter state sync, sending side
+ *
+ * Parameters are bound once to an id and an address. set*() only marks a
+ * parameter dirty when its value changes; flush() packs the dirty values
+ * into bundles of at most SYNC_MTU bytes. Every bundle starts with a
+ * "/sync" ,ii message (sequence number, flags) so the receiver can detect
+ * loss. Full snapshots go out on request and every snapshot interval.
+ * Parameters stay dirty until the bundle carrying them was sent; a failed
+ * send ends the flush, and the rest goes out on the next one.
+ *
+ * Addresses are not copied and must outlive the sender.
+ *
+ * Usage:
+ *   OSCStateSender<2000> state;
+ *   state.bind(0, "/mixer/1/gain");
+ *   state.setFloat(0, 0.5f);
+ *   state.flush(client);  // each tick
+ */
+template<std::size_t N>
+class OSCStateSender
+{
+public:
+    OSCStateSender()
+    {
+        std::memset(mDirty, 0, sizeof(mDirty));
+        for (Param& param : mParams) {
+            param.address = nullptr;
+            param.type = 'f';
+            param.i = 0;
+        }
+    }
+
+    bool bind(std::size_t id, const char* address)
+    {
+        if (id >= N || !address) return false;
+        mParams[id].address = address;
+        markDirty(id);
+        return true;
+    }
+
+    bool setFloat(std::size_t id, float value)
+    {
+        if (id >= N) return false;
+        Param& param = mParams[id];
+        if (param.type != 'f' || std::memcmp(&param.f, &value, sizeof(value)) != 0) {
+            param.type = 'f';
+            param.f = value;
+            markDirty(id);
+        }
+        return true;
+    }
+
+    bool setInt(std::size_t id, int32_t value)
+    {
+        if (id >= N) return false;
+        Param& param = mParams[id];
+        if (param.type != 'i' || param.i != value) {
+            param.type = 'i';
+            param.i = value;
+            markDirty(id);
+        }
+        return true;
+    }
+
+    /**
+     * Send every bound parameter on the next flush()
+     */
+    void requestSnapshot() { mSnapshotPending = true; }
+
+    /**
+     * Send a full snapshot at least this often (0 = only on request)
+     */
+    void setSnapshotInterval(uint32_t intervalMs)
+    {
+        mSnapshotIntervalUs = static_cast<uint64_t>(intervalMs) * 1000;
+        mLastSnapshot = monotonicMicros64();
+    }
+
+    /**
+     * Answer a receiver's "/sync/resync" request
+     * @return true if the message was a resync request
+     */
+    bool handleRequest(const OSCMessageView& msg)
+    {
+        if (!msg.address() || std::strcmp(msg.address(), SYNC_RESYNC_ADDRESS) != 0) return false;
+        requestSnapshot();
+        return true;
+    }
+
+    /**
+     * Send dirty parameters (or a full snapshot when one is due)
+     * @param destination OSCClient, OSCClientGroup or OSCTcpClient
+     * @return Number of bundles sent
+     */
+    template<typename Destination>
+    std::size_t flush(Destination& destination)
+    {
+        const uint64_t now = monotonicMicros64();
+        if (mSnapshotIntervalUs != 0 && now - mLastSnapshot >= mSnapshotIntervalUs) {
+            mSnapshotPending = true;
+        }
+
+        const bool snapshot = mSnapshotPending;
+        if (snapshot) {
+            mSnapshotPending = false;
+            mLastSnapshot = now;
+        } else if (mDirtyCount == 0) {
+            return 0;
+        }
+
+        // Dirty bits of the ids in a bundle are cleared once it was sent
+        std::size_t bundles = 0;
+        OSCSyncFlags flags = snapshot ? OSCSyncFlags::SnapshotBegin : OSCSyncFlags::None;
+        std::size_t first = 0;
+        if (!beginBundle(flags)) return 0;
+
+        for (std::size_t word = 0; word < WORDS; word++) {
+            uint32_t bits = snapshot ? ~0u : mDirty[word];
+            while (bits) {
+                const std::size_t id = word * 32 + static_cast<std::size_t>(__builtin_ctz(bits));
+                bits &= bits - 1;
+                if (id >= N || !mParams[id].address) continue;
+
+                buildParam(id);
+                if (mBundle.addMessage(mMessage, SYNC_MTU)) continue;
+
+                if (!sendBundle(destination, first, id, snapshot)) return bundles;
+                bundles++;
+                first = id;
+                flags = OSCSyncFlags::None;
+                if (!beginBundle(flags)) return bundles;
+                if (!mBundle.addMessage(mMessage, SYNC_MTU)) {
+                    // Cannot fit even alone: drop it rather than retry forever
+                    PICOOSC_LOG_WARN("picoosc: sync parameter %s exceeds SYNC_MTU\n", mParams[id].address);
+                    clearDirty(id, id + 1);
+                    first = id + 1;
+                }
+            }
+        }
+
+        if (snapshot) mBundle.patchInt(mFlagsOffset, static_cast<int32_t>(flags | OSCSyncFlags::SnapshotEnd));
+        if (sendBundle(destination, first, N, snapshot)) bundles++;
+        return bundles;
+    }
+
+    std::size_t dirtyCount() const { return mDirtyCount; }
+    uint32_t sequence() const { return mSequence; }
+
+private:
+    struct Param
+    {
+        const char* address;
+        char type;
+        union {
+            int32_t i;
+            float f;
+        };
+    };
+
+    static constexpr std::size_t WORDS = (N + 31) / 32;
+
+    void markDirty(std::size_t id)
+    {
+        uint32_t& word = mDirty[id / 32];
+        const uint32_t bit = 1u << (id % 32);
+        if (!(word & bit)) {
+            word |= bit;
+            mDirtyCount++;
+        }
+    }
+
+    void clearDirty(std::size_t first, std::size_t last)
+    {
+        for (std::size_t id = first; id < last; id++) {
+            uint32_t& word = mDirty[id / 32];
+            const uint32_t bit = 1u << (id % 32);
+            if (word & bit) {
+                word &= ~bit;
+                mDirtyCount--;
+            }
+        }
+    }
+
+    /**
+     * Send the current bundle, which holds the parameters in [first, last)
+     * The sequence number only advances on success, so a failed send does
+     * not look like a lost packet to receivers. A failed snapshot is
+     * retried in full on the next flush().
+     */
+    template<typename Destination>
+    bool sendBundle(Destination& destination, std::size_t first, std::size_t last, bool snapshot)
+    {
+        if (!mBundle.send(destination)) {
+            if (snapshot) mSnapshotPending = true;
+            return false;
+        }
+        mSequence++;
+        clearDirty(first, last);
+        return true;
+    }
+
+    /**
+     * Start a bundle with the "/sync" header; its flags argument is the
+     * last 4 bytes of the header, so its offset is remembered for patching
+     */
+    bool beginBundle(OSCSyncFlags flags)
+    {
+        mBundle.clear();
+        mBundle.setTimetag(OSCTimetag::immediate());
+        OSCMessage header;
+        header.setAddress(SYNC_ADDRESS);
+        header.addInt(static_cast<int32_t>(mSequence));
+        header.addInt(static_cast<int32_t>(flags));
+        if (!mBundle.addMessage(header)) return false;
+        mFlagsOffset = mBundle.size() - 4;
+        return true;
+    }
+
+    void buildParam(std::size_t id)
+    {
+        const Param& param = mParams[id];
+        mMessage.clear();
+        mMessage.setAddress(param.address);
+        if (param.type == 'i') {
+            mMessage.addInt(param.i);
+        } else {
+            mMessage.addFloat(param.f);
+        }
+    }
+
+    Param mParams[N];
+    uint32_t mDirty[WORDS];
+    std::size_t mDirtyCount = 0;
+    uint32_t mSequence = 0;
+    bool mSnapshotPending = true;  // The first flush sends everything
+    uint64_t mSnapshotIntervalUs = 0;
+    uint64_t mLastSnapshot = 0;
+    std::size_t mFlagsOffset = 0;
+    OSCBundle mBundle;
+    OSCMessage mMessage;
+};
+
+/**
+ * Delta-encoded parameter state sync, receiving side
+ *
+ * Feed every received message to handle(); parameter messages are left to
+ * the application. Tracks the "/sync" sequence numbers and flags when a
+ * gap means the mirrored state may be stale until the next full snapshot.
+ */
+class OSCStateReceiver
+{
+public:
+    /**
+     * @return true if the message was a "/sync" header (nothing else to do)
+     */
+    bool handle(const OSCMessageView& msg)
+    {
+        if (!msg.address() || std::strcmp(msg.address(), SYNC_ADDRESS) != 0) return false;
+
+        const uint32_t seq = static_cast<uint32_t>(msg.getInt(0));
+        const int32_t flags = msg.getInt(1);
+
+        if (mStarted) {
+            const int32_t gap = static_cast<int32_t>(seq - mExpected);
+            if (gap < 0) {
+                mLatePackets++;  // Reordered or duplicated; ignore
+                return true;
+            }
+            if (gap > 0) {
+                mLostPackets += static_cast<uint32_t>(gap);
+                mResyncNeeded = true;
+                mSnapshotClean = false;
+            }
+        } else {
+            mStarted = true;
+            mResyncNeeded = !hasSyncFlag(flags, OSCSyncFlags::SnapshotBegin);
+        }
+        mExpected = seq + 1;
+
+        if (hasSyncFlag(flags, OSCSyncFlags::SnapshotBegin)) mSnapshotClean = true;
+        if (hasSyncFlag(flags, OSCSyncFlags::SnapshotEnd) && mSnapshotClean) mResyncNeeded = false;
+        return true;
+    }
+
+    /**
+     * Ask the sender for a full snapshot
+     */
+    bool requestResync(OSCClient& client) const
+    {
+        OSCMessage msg;
+        msg.setAddress(SYNC_RESYNC_ADDRESS);
+        return msg.send(client);
+    }
+
+    /**
+     * True after a gap until a complete snapshot has arrived
+     */
+    bool resyncNeeded() const { return mResyncNeeded; }
+    uint32_t lostPackets() const { return mLostPackets; }
+    uint32_t latePackets() const { return mLatePackets; }
+
+private:
+    bool mStarted = false;
+    bool mResyncNeeded = true;
+    bool mSnapshotClean = false;
+    uint32_t mExpected = 0;
+    uint32_t mLostPackets = 0;
+    uint32_t mLatePackets = 0;
+};
+
+/**
+ * Addresses used by OSCClockSync / OSCClockMaster
+ */
+static constexpr const char* CLOCK_PING_ADDRESS = "/clock/ping";
+static constexpr const char* CLOCK_PONG_ADDRESS = "/clock/pong";
+
+/**
+ * Synchronized NTP time from the local monotonic clock
+ *
+ * now() maps monotonicMicros64() through a calibration: a local time, the
+ * NTP time it corresponds to, and the drift of the local oscillator.
+ * OSCClockSync keeps it up to date; a host acting as the time master sets
+ * it once from the wall clock. Until then time counts from the NTP epoch
+ * at boot. The calibration has one writer and is read lock-free from any
+ * core (seqlock). now() costs a 64-bit clock read plus the 64-bit
+ * multiplies of the drift correction and ntpFromMicros(), about ten
+ * 32x32 multiplies in all on cores without a 64-bit multiplier (M0+).
+ *
+ * A reader spins while calibrate() runs, so never call now() from an
+ * interrupt handler that can preempt calibrate() on the same core; it
+ * would spin forever. Read it from thread context or the other core.
+ */
+class OSCClock
+{
+public:
+    /**
+     * Current synchronized time
+     */
+    static OSCTimetag now() { return fromLocal(monotonicMicros64()); }
+
+    /**
+     * Synchronized time of a monotonicMicros64() stamp
+     */
+    static OSCTimetag fromLocal(uint64_t localMicros)
+    {
+        const Calibration c = load();
+        const int64_t delta = static_cast<int64_t>(localMicros - c.localMicros);
+        const int64_t corrected = delta + ((delta * c.drift) >> 32);
+        return OSCTimetag::fromRaw(c.ntp).addMicros(corrected);
+    }
+
+    /**
+     * Map a local stamp to an NTP time
+     * @param drift Master seconds per local second, minus one, in 2^-32 units
+     */
+    static void calibrate(uint64_t localMicros, OSCTimetag reference, int32_t drift)
+    {
+        sSequence.store(sSequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        sCalibration.localMicros = localMicros;
+        sCalibration.ntp = reference.raw();
+        sCalibration.drift = drift;
+        sCalibration.synchronized = true;
+        std::atomic_thread_fence(std::memory_order_release);
+        sSequence.store(sSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * Make now() return the given time (e.g. on the master)
+     */
+    static void set(OSCTimetag current) { calibrate(monotonicMicros64(), current, load().drift); }
+
+    static bool synchronized() { return load().synchronized; }
+
+private:
+    struct Calibration
+    {
+        uint64_t localMicros;
+        uint64_t ntp;
+        int32_t drift;
+        bool synchronized;
+    };
+
+    static Calibration load()
+    {
+        Calibration c;
+        uint32_t sequence;
+        do {
+            sequence = sSequence.load(std::memory_order_acquire);
+            c = sCalibration;
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((sequence & 1) != 0 || sequence != sSequence.load(std::memory_order_relaxed));
+        return c;
+    }
+
+    static inline Calibration sCalibration = {};
+    static inline std::atomic<uint32_t> sSequence{0};
+};
+
+/**
+ * Answers OSCClockSync requests; run it on the machine that keeps time
+ *
+ * Each pong echoes the requester's stamp and id, so clients sharing a
+ * reply destination (e.g. a broadcast) only accept their own.
+ *
+ * Usage (host master):
+ *   OSCClock::set(OSCTimetag::fromUnixMicros(wallClockMicros()));
+ *   server.addHandler(CLOCK_PING_ADDRESS, [&](const OSCMessageView& msg) { master.handle(msg, picos); });
+ */
+class OSCClockMaster
+{
+public:
+    /**
+     * Reply to a "/clock/ping" ,hi with "/clock/pong" ,htti (the echoed
+     * local stamp, receive time, send time, echoed client id)
+     * @return true if the message was a ping
+     */
+    template<typename Destination>
+    bool handle(const OSCMessageView& msg, Destination& reply)
+    {
+        if (!msg.address() || std::strcmp(msg.address(), CLOCK_PING_ADDRESS) != 0) return false;
+        const OSCTimetag received = OSCClock::now();
+        const OSCArg* stamp = msg.arg(0);
+        const OSCArg* id = msg.arg(1);
+        if (!stamp || stamp->type != 'h' || !id || id->type != 'i') return true;
+
+        OSCMessage pong;
+        pong.setAddress(CLOCK_PONG_ADDRESS);
+        pong.addInt64(stamp->h);
+        pong.addTimetag(received);
+        pong.addTimetag(OSCClock::now());
+        pong.addInt(id->i);
+        if (pong.send(reply)) mAnswered++;
+        return true;
+    }
+
+    uint32_t answered() const { return mAnswered; }
+
+private:
+    uint32_t mAnswered = 0;
+};
+
+/**
+ * NTP-style clock synchronization, client side
+ *
+ * Call requestSync() periodically (e.g. once a second) and feed received
+ * messages to handle(). Each round trip gives an offset and a delay; the
+ * offset of the fastest of the last CLOCK_SAMPLES round trips wins, since
+ * queuing only ever adds delay. The drift of the local oscillator is the
+ * slope of the winning offsets over at least DRIFT_INTERVAL_US, smoothed
+ * and limited to MAX_DRIFT_PPM; a larger change is taken as a step of the
+ * master's clock and restarts the drift measurement. Every accepted reply
+ * recalibrates OSCClock, so now() may step by the size of the correction.
+ *
+ * Only a pong that echoes this client's id and its latest request is
+ * accepted. Give each client a distinct id (e.g. from its board id or IP
+ * address) when the master replies to a shared destination.
+ */
+class OSCClockSync
+{
+public:
+    static constexpr uint64_t DRIFT_INTERVAL_US = 10000000;
+    static constexpr uint64_t MAX_ROUND_TRIP_US = 1000000;  // Older replies are ignored
+    static constexpr int64_t MAX_DRIFT_PPM = 500;
+
+    explicit OSCClockSync(int32_t id = 0)
+        : mId(id)
+    {
+    }
+
+    /**
+     * Send a "/clock/ping" with the local send time and the client id
+     * Call it from the same context as handle().
+     */
+    bool requestSync(OSCClient& master)
+    {
+        mPending = monotonicMicros64();
+        OSCMessage msg;
+        msg.setAddress(CLOCK_PING_ADDRESS);
+        msg.addInt64(static_cast<int64_t>(mPending));
+        msg.addInt(mId);
+        return msg.send(master);
+    }
+
+    /**
+     * @return true if the message was a "/clock/pong" (nothing else to do)
+     */
+    bool handle(const OSCMessageView& msg)
+    {
+        if (!msg.address() || std::strcmp(msg.address(), CLOCK_PONG_ADDRESS) != 0) return false;
+        const uint64_t arrived = monotonicMicros64();
+        const OSCArg* stamp = msg.arg(0);
+        const OSCArg* received = msg.arg(1);
+        const OSCArg* sent = msg.arg(2);
+        const OSCArg* id = msg.arg(3);
+        if (!stamp || !received || !sent || !id || stamp->type != 'h' || received->type != 't' ||
+            sent->type != 't' || id->type != 'i') {
+            return true;
+        }
+        // Another client's reply, or a duplicate of one already used
+        const uint64_t requested = static_cast<uint64_t>(stamp->h);
+        if (id->i != mId || requested != mPending) return true;
+        mPending = 0;
+        if (requested > arrived || arrived - requested > MAX_ROUND_TRIP_US) return true;
+
+        // All in 32.32 NTP units; the local side uses the raw local clock
+        const uint64_t t1 = OSCTimetag::ntpFromMicros(requested);
+        const uint64_t t4 = OSCTimetag::ntpFromMicros(arrived);
+        const uint64_t t2 = received->t.raw();
+        const uint64_t t3 = sent->t.raw();
+        const uint64_t a = t2 - t1;
+        const uint64_t b = t3 - t4;
+
+        Sample& sample = mSamples[mNext];
+        mNext = (mNext + 1) % CLOCK_SAMPLES;
+        if (mCount < CLOCK_SAMPLES) mCount++;
+        sample.local = requested + (arrived - requested) / 2;
+        sample.offset = a + static_cast<uint64_t>(static_cast<int64_t>(b - a) / 2);
+        sample.delay = static_cast<int64_t>(t4 - t1) - static_cast<int64_t>(t3 - t2);
+        if (sample.delay < 0) sample.delay = 0;
+
+        const Sample& best = bestSample();
+        updateDrift(best);
+        OSCClock::calibrate(best.local, OSCTimetag::fromRaw(OSCTimetag::ntpFromMicros(best.local) + best.offset),
+                            mDrift);
+        mSynchronized = true;
+        return true;
+    }
+
+    bool synchronized() const { return mSynchronized; }
+
+    /**
+     * Drift of the local clock against the master, in parts per billion
+     */
+    int32_t driftPpb() const { return static_cast<int32_t>((static_cast<int64_t>(mDrift) * 1000000000) >> 32); }
+
+    // Id sent in pings and expected back in pongs
+    int32_t id() const { return mId; }
+
+    /**
+     * Round trip of the sample in use, in microseconds
+     */
+    uint32_t roundTripMicros() const
+    {
+        if (mCount == 0) return 0;
+        return static_cast<uint32_t>(OSCTimetag::microsFromNtp(static_cast<uint64_t>(bestSample().delay)));
+    }
+
+private:
+    struct Sample
+    {
+        uint64_t local;   // Midpoint of the round trip, local microseconds
+        uint64_t offset;  // Master minus local, 32.32 (modulo 2^64)
+        int64_t delay;    // Round trip minus master processing, 32.32
+    };
+
+    const Sample& bestSample() const
+    {
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < mCount; i++) {
+            if (mSamples[i].delay < mSamples[best].delay) best = i;
+        }
+        return mSamples[best];
+    }
+
+    void updateDrift(const Sample& best)
+    {
+        if (mCount < CLOCK_SAMPLES) return;  // Let the filter settle first
+        if (!mHasAnchor) {
+            mAnchor = best;
+            mHasAnchor = true;
+            return;
+        }
+        if (best.local < mAnchor.local + DRIFT_INTERVAL_US) return;
+
+        // A change beyond MAX_DRIFT_PPM is a step (e.g. the master was
+        // restarted or set), not drift: measure again from here. This also
+        // keeps change * 2^16 below in range.
+        const int64_t change = static_cast<int64_t>(best.offset - mAnchor.offset);
+        const uint64_t elapsedMicros = best.local - mAnchor.local;
+        const int64_t elapsed = static_cast<int64_t>(OSCTimetag::ntpFromMicros(elapsedMicros));
+        const int64_t limit = elapsed / 1000000 * MAX_DRIFT_PPM;
+        if (elapsedMicros > MAX_ANCHOR_AGE_US || change > limit || change < -limit) {
+            mAnchor = best;
+            return;
+        }
+
+        // Offset change per unit of local time, as a 2^-32 ratio
+        const int64_t slope = (change * (int64_t(1) << 16)) / (elapsed >> 16);
+        mDrift = mDriftValid ? static_cast<int32_t>(mDrift + (slope - mDrift) / 4) : static_cast<int32_t>(slope);
+        mDriftValid = true;
+        mAnchor = best;
+    }
+
+    // Bounds elapsed, so change * 2^16 cannot overflow
+    static constexpr uint64_t MAX_ANCHOR_AGE_US = 3600000000;
+
+    Sample mSamples[CLOCK_SAMPLES] = {};
+    std::size_t mCount = 0;
+    std::size_t mNext = 0;
+    uint64_t mPending = 0;  // Stamp of the latest request
+    int32_t mId = 0;
+    Sample mAnchor = {};
+    bool mHasAnchor = false;
+    bool mDriftValid = false;
+    bool mSynchronized = false;
+    int32_t mDrift = 0;
+};
+
+/**
+ * Allocation-free std::function replacement
+ *
+ * Stores a callable (function pointer or lambda, with captures) inline in
+ * a fixed buffer of Capacity bytes and calls it through one indirect
+ * call. Never touches the heap; a closure that does not fit fails to
+ * compile, so capture a pointer to larger state instead. Trivially
+ * copyable closures (the common case: captured pointers and references)
+ * are copied with memcpy and need no destructor call.
+ */
+template<typename Signature, std::size_t Capacity = HANDLER_STORAGE_SIZE>
+class OSCInlineFunction;
+
+template<typename R, typename... Args, std::size_t Capacity>
+class OSCInlineFunction<R(Args...), Capacity>
+{
+public:
+    OSCInlineFunction() = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, OSCInlineFunction>::value>>
+    OSCInlineFunction(F&& function)
+    {
+        assign(std::forward<F>(function));
+    }
+
+    OSCInlineFunction(const OSCInlineFunction& other) { copyFrom(other); }
+
+    OSCInlineFunction& operator=(const OSCInlineFunction& other)
+    {
+        if (this != &other) {
+            reset();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, OSCInlineFunction>::value>>
+    OSCInlineFunction& operator=(F&& function)
+    {
+        reset();
+        assign(std::forward<F>(function));
+        return *this;
+    }
+
+    ~OSCInlineFunction() { reset(); }
+
+    void reset()
+    {
+        if (mDestroy) mDestroy(mStorage);
+        mInvoke = nullptr;
+        mCopy = nullptr;
+        mDestroy = nullptr;
+    }
+
+    explicit operator bool() const { return mInvoke != nullptr; }
+
+    R operator()(Args... args) const { return mInvoke(mStorage, std::forward<Args>(args)...); }
+
+private:
+    template<typename F>
+    void assign(F&& function)
+    {
+        using T = std::decay_t<F>;
+        static_assert(sizeof(T) <= Capacity,
+                      "Handler closure does not fit inline; capture a pointer or raise HANDLER_STORAGE_SIZE");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Handler closure is over-aligned");
+
+        new (mStorage) T(std::forward<F>(function));
+        mInvoke = [](const void* storage, Args... args) -> R {
+            return (*static_cast<T*>(const_cast<void*>(storage)))(std::forward<Args>(args)...);
+        };
+        if (!std::is_trivially_copyable<T>::value || !std::is_trivially_destructible<T>::value) {
+            mCopy = [](void* to, const void* from) { new (to) T(*static_cast<const T*>(from)); };
+            mDestroy = [](void* storage) { static_cast<T*>(storage)->~T(); };
+        }
+    }
+
+    void copyFrom(const OSCInlineFunction& other)
+    {
+        if (other.mCopy) {
+            other.mCopy(mStorage, other.mStorage);
+        } else {
+            std::memcpy(mStorage, other.mStorage, Capacity);
+        }
+        mInvoke = other.mInvoke;
+        mCopy = other.mCopy;
+        mDestroy = other.mDestroy;
+    }
+
+    alignas(std::max_align_t) unsigned char mStorage[Capacity];
+    R (*mInvoke)(const void* storage, Args... args) = nullptr;
+    void (*mCopy)(void* to, const void* from) = nullptr;
+    void (*mDestroy)(void* storage) = nullptr;
+};
+
+/**
+ * Per-endpoint message handler (inline closure, no heap)
+ */
+using OSCHandler = OSCInlineFunction<void(const OSCMessageView& msg)>;
+
+/**
+ * Handler for a compile-time endpoint table
+ */
+using OSCStaticHandler = void (*)(const OSCMessageView& msg);
+
+/**
+ * One entry of a compile-time endpoint table
+ */
+struct OSCEndpoint
+{
+    const char* address;
+    OSCStaticHandler handler;
+};
+
+/**
+ * Slot of a built OSCStaticRoutes table
+ */
+struct OSCStaticEndpoint
+{
+    const char* address;
+    std::size_t length;
+    OSCStaticHandler handler;
+};
+
+/**
+ * Non-owning view of an OSCStaticRoutes table, used by the dispatcher
+ */
+struct OSCStaticRouteView
+{
+    const OSCStaticEndpoint* slots = nullptr;
+    const uint16_t* displacement = nullptr;
+    uint32_t slotMask = 0;
+    uint32_t bucketMask = 0;
+    bool valid = false;
+
+    static constexpr uint32_t hash(const char* address, std::size_t length)
+    {
+        uint32_t h = 2166136261u;  // FNV-1a
+        for (std::size_t i = 0; i < length; i++) {
+            h = (h ^ static_cast<uint8_t>(address[i])) * 16777619u;
+        }
+        return h;
+    }
+
+    static constexpr uint32_t slotHash(uint32_t h, uint32_t displacement)
+    {
+        uint32_t x = h ^ (displacement * 0x9E3779B9u);  // murmur3 finalizer
+        x ^= x >> 16;
+        x *= 0x85EBCA6Bu;
+        x ^= x >> 13;
+        x *= 0xC2B2AE35u;
+        x ^= x >> 16;
+        return x;
+    }
 
-        // Parse type tag string
-        if (pos >= size || buffer[pos] != ',') {
-            // No type tags = no arguments (valid)
-            mTypeTags = "";
-            return true;
-        }
+    /**
+     * One string hash, one table load and one memcmp
+     * @return The endpoint for an exact address, or nullptr
+     */
+    const OSCStaticEndpoint* find(const char* address, std::size_t length) const
+    {
+        if (!slots) return nullptr;
+        const uint32_t h = hash(address, length);
+        const OSCStaticEndpoint& slot = slots[slotHash(h, displacement[h & bucketMask]) & slotMask];
+        return (slot.length == length && slot.address && std::memcmp(slot.address, address, length) == 0)
+                   ? &slot
+                   : nullptr;
+    }
+};
 
-        mTypeTags = buffer + pos + 1;  // Skip comma
-        while (pos < size && buffer[pos] != '\0') pos++;
-        if (pos >= size) return false;
-        pos++;
-        pos = (pos + 3) & ~3;
+// Called only when an OSCStaticRoutes table cannot be built; being
+// non-constexpr, it turns the failure into a compile error when the table
+// is constexpr. A table built at run time reports it through valid().
+inline void oscStaticRoutesDuplicateAddress() {}
+inline void oscStaticRoutesNoPerfectHash() {}
 
-        // Parse arguments based on type tags
-        const char* types = mTypeTags;
-        while (*types && mArgCount < MAX_ARGS) {
-            OSCArg& arg = mArgs[mArgCount];
-            arg.type = *types;
-            arg.s = nullptr;
-            arg.blobData = nullptr;
+/**
+ * Endpoint table with a perfect hash built at compile time
+ *
+ * For firmware whose endpoints are fixed: declare the table constexpr and
+ * it lands in flash, costing no RAM. Lookup is one string hash, one
+ * displacement load and one memcmp (hash-and-displace: keys are grouped
+ * into buckets, and each bucket stores the displacement that sends its
+ * keys to free slots).
+ *
+ *   constexpr OSCEndpoint endpoints[] = {
+ *       {"/synth/freq", onFreq},
+ *       {"/synth/gain", onGain},
+ *   };
+ *   static constexpr OSCStaticRoutes<2> routes(endpoints);
+ *   server.setStaticRoutes(routes.view());
+ *
+ * A duplicate address, or a key set with no perfect hash, fails the build
+ * for a constexpr table. A table built at run time is left invalid
+ * instead: valid() is false, its view matches nothing and
+ * setStaticRoutes() rejects it. The table must have static storage
+ * duration; the view points into it.
+ */
+template<std::size_t N>
+class OSCStaticRoutes
+{
+public:
+    static_assert(N > 0, "OSCStaticRoutes needs at least one endpoint");
 
-            switch (*types) {
-                case 'i':  // int32
-                    if (pos + 4 > size) return false;
-                    std::memcpy(&arg.i, buffer + pos, 4);
-                    arg.i = swap_endian(arg.i);
-                    pos += 4;
-                    break;
+    static constexpr std::size_t ceilPow2(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
 
-                case 'f':  // float32
-                    if (pos + 4 > size) return false;
-                    std::memcpy(&arg.f, buffer + pos, 4);
-                    arg.f = swap_endian_float(arg.f);
-                    pos += 4;
-                    break;
+    static constexpr std::size_t SLOTS = ceilPow2(2 * N);
+    static constexpr std::size_t BUCKETS = ceilPow2(N);
 
-                case 's':  // string
-                case 'S':  // symbol (treated same as string)
-                    arg.s = buffer + pos;
-                    while (pos < size && buffer[pos] != '\0') pos++;
-                    if (pos >= size) return false;
-                    pos++;
-                    pos = (pos + 3) & ~3;
-                    break;
+    constexpr explicit OSCStaticRoutes(const OSCEndpoint (&endpoints)[N])
+        : mSlots{}
+        , mDisplacement{}
+        , mValid(true)
+    {
+        uint32_t hashes[N] = {};
+        std::size_t lengths[N] = {};
+        for (std::size_t i = 0; i < N; i++) {
+            while (endpoints[i].address[lengths[i]] != '\0') lengths[i]++;
+            hashes[i] = OSCStaticRouteView::hash(endpoints[i].address, lengths[i]);
+            for (std::size_t j = 0; j < i; j++) {
+                if (lengths[j] == lengths[i] && sameAddress(endpoints[i].address, endpoints[j].address, lengths[i])) {
+                    oscStaticRoutesDuplicateAddress();
+                    mValid = false;
+                    return;
+                }
+            }
+        }
 
-                case 'b':  // blob
-                    if (pos + 4 > size) return false;
-                    std::memcpy(&arg.blobSize, buffer + pos, 4);
-                    arg.blobSize = swap_endian(arg.blobSize);
-                    pos += 4;
-                    if (pos + static_cast<std::size_t>(arg.blobSize) > size) return false;
-                    arg.blobData = reinterpret_cast<const uint8_t*>(buffer + pos);
-                    pos += static_cast<std::size_t>(arg.blobSize);
-                    pos = (pos + 3) & ~3;
-                    break;
+        // Largest buckets first, while most slots are still free
+        std::size_t bucketSize[BUCKETS] = {};
+        for (std::size_t i = 0; i < N; i++) bucketSize[hashes[i] & (BUCKETS - 1)]++;
+        std::size_t order[BUCKETS] = {};
+        for (std::size_t b = 0; b < BUCKETS; b++) order[b] = b;
+        for (std::size_t a = 0; a < BUCKETS; a++) {
+            for (std::size_t b = a + 1; b < BUCKETS; b++) {
+                if (bucketSize[order[b]] > bucketSize[order[a]]) {
+                    const std::size_t t = order[a];
+                    order[a] = order[b];
+                    order[b] = t;
+                }
+            }
+        }
 
-                case 'h':  // int64
-                    if (pos + 8 > size) return false;
-                    std::memcpy(&arg.h, buffer + pos, 8);
-                    arg.h = swap_endian(arg.h);
-                    pos += 8;
-                    break;
+        bool used[SLOTS] = {};
+        for (std::size_t k = 0; k < BUCKETS && bucketSize[order[k]] > 0; k++) {
+            const std::size_t bucket = order[k];
+            bool placed = false;
+            for (uint32_t d = 0; d < 0xFFFF && !placed; d++) {
+                std::size_t claimed[N] = {};
+                std::size_t count = 0;
+                bool ok = true;
+                for (std::size_t i = 0; i < N && ok; i++) {
+                    if ((hashes[i] & (BUCKETS - 1)) != bucket) continue;
+                    const std::size_t slot = OSCStaticRouteView::slotHash(hashes[i], d) & (SLOTS - 1);
+                    ok = !used[slot];
+                    for (std::size_t c = 0; c < count && ok; c++) ok = (claimed[c] != slot);
+                    claimed[count++] = slot;
+                }
+                if (!ok) continue;
+
+                count = 0;
+                for (std::size_t i = 0; i < N; i++) {
+                    if ((hashes[i] & (BUCKETS - 1)) != bucket) continue;
+                    const std::size_t slot = claimed[count++];
+                    used[slot] = true;
+                    mSlots[slot] = OSCStaticEndpoint{endpoints[i].address, lengths[i], endpoints[i].handler};
+                }
+                mDisplacement[bucket] = static_cast<uint16_t>(d);
+                placed = true;
+            }
+            if (!placed) {
+                oscStaticRoutesNoPerfectHash();
+                mValid = false;
+                return;
+            }
+        }
+    }
 
-                case 'd':  // double
-                    if (pos + 8 > size) return false;
-                    std::memcpy(&arg.d, buffer + pos, 8);
-                    arg.d = swap_endian_double(arg.d);
-                    pos += 8;
-                    break;
+    /**
+     * False if the endpoints could not be built into a table
+     */
+    constexpr bool valid() const { return mValid; }
 
-                case 't':  // timetag
-                    if (pos + 8 > size) return false;
-                    std::memcpy(&arg.t.seconds, buffer + pos, 4);
-                    std::memcpy(&arg.t.fractions, buffer + pos + 4, 4);
-                    arg.t.seconds = swap_endian(arg.t.seconds);
-                    arg.t.fractions = swap_endian(arg.t.fractions);
-                    pos += 8;
-                    break;
+    /**
+     * @return The table's view, or an empty (invalid) view if !valid()
+     */
+    constexpr OSCStaticRouteView view() const
+    {
+        OSCStaticRouteView view;
+        if (!mValid) return view;
+        view.slots = mSlots;
+        view.displacement = mDisplacement;
+        view.slotMask = static_cast<uint32_t>(SLOTS - 1);
+        view.bucketMask = static_cast<uint32_t>(BUCKETS - 1);
+        view.valid = true;
+        return view;
+    }
 
-                case 'm':  // MIDI
-                    if (pos + 4 > size) return false;
-                    arg.midi.port = static_cast<uint8_t>(buffer[pos]);
-                    arg.midi.status = static_cast<uint8_t>(buffer[pos + 1]);
-                    arg.midi.data1 = static_cast<uint8_t>(buffer[pos + 2]);
-                    arg.midi.data2 = static_cast<uint8_t>(buffer[pos + 3]);
-                    pos += 4;
-                    break;
+    const OSCStaticEndpoint* find(const char* address) const { return view().find(address, std::strlen(address)); }
 
-                case 'c':  // char (stored as int32)
-                    if (pos + 4 > size) return false;
-                    arg.c = buffer[pos + 3];  // Last byte
-                    pos += 4;
-                    break;
+private:
+    static constexpr bool sameAddress(const char* a, const char* b, std::size_t length)
+    {
+        for (std::size_t i = 0; i < length; i++) {
+            if (a[i] != b[i]) return false;
+        }
+        return true;
+    }
 
-                case 'r':  // RGBA color
-                    if (pos + 4 > size) return false;
-                    arg.color.r = static_cast<uint8_t>(buffer[pos]);
-                    arg.color.g = static_cast<uint8_t>(buffer[pos + 1]);
-                    arg.color.b = static_cast<uint8_t>(buffer[pos + 2]);
-                    arg.color.a = static_cast<uint8_t>(buffer[pos + 3]);
-                    pos += 4;
-                    break;
+    OSCStaticEndpoint mSlots[SLOTS];
+    uint16_t mDisplacement[BUCKETS];
+    bool mValid;
+};
 
-                case 'T':  // True
-                case 'F':  // False
-                case 'N':  // Nil
-                case 'I':  // Infinitum
-                    // No data bytes
-                    break;
+/**
+ * Callback type for received OSC messages
+ */
+using OSCCallback = void (*)(const OSCMessageView& msg, void* userData);
 
-                default:
-                    // Unknown type, skip
-                    break;
+/**
+ * Observer for every raw packet a dispatcher receives (e.g. a capture log)
+ */
+using OSCPacketTap = void (*)(const char* buffer, std::size_t size, void* userData);
+
+/**
+ * Routes complete OSC packets (messages or bundles) to a callback
+ *
+ * Shared by the UDP and TCP servers. Can also be fed directly with
+ * processPacket(), e.g. from a serial link.
+ */
+class OSCDispatcher
+{
+public:
+    /**
+     * Set the function to call for every received message
+     */
+    void setCallback(OSCCallback callback, void* userData = nullptr)
+    {
+        mCallback = callback;
+        mUserData = userData;
+    }
+
+    /**
+     * Register a typed handler for an exact address
+     *
+     * The expected type tags are generated from the template arguments, so
+     * a message is accepted with one memcmp and its arguments are decoded
+     * straight into the handler's parameters. Messages to the address with
+     * other tags fall through to the callback.
+     *
+     *   server.on<float, int32_t>("/voice/note", [&synth](float velocity, int32_t note) { ... });
+     *
+     * A handler may take a leading OSCTimetag before the message arguments
+     * to receive the effective timetag of the enclosing bundle
+     * (OSCTimetag::immediate() for a bare message):
+     *
+     *   server.on<float>("/cue/go", [&cues](OSCTimetag when, float fade) { ... });
+     *
+     * The handler is stored inline (see OSCInlineFunction), and the address
+     * is not copied.
+     * @return false if MAX_ROUTES handlers are already registered
+     */
+    template<typename... Args, typename F>
+    bool on(const char* address, F handler)
+    {
+        if (!address || mRouteCount >= MAX_ROUTES) return false;
+
+        Route& route = mRoutes[mRouteCount++];
+        route.address = address;
+        route.tags = OSCTypeSignature<Args...>::tags;
+        route.tagCount = OSCTypeSignature<Args...>::size;
+        route.call = [handler](const char* args, const char* end, OSCTimetag timetag) mutable {
+            std::tuple<std::decay_t<Args>...> values;
+            if (!decodeOSCArgs(args, end, values, std::index_sequence_for<Args...>{})) return false;
+            if constexpr (std::is_invocable_v<F&, OSCTimetag, std::decay_t<Args>&...>) {
+                std::apply([&](auto&... v) { handler(timetag, v...); }, values);
+            } else {
+                (void)timetag;
+                std::apply(handler, values);
             }
+            return true;
+        };
+        return true;
+    }
 
-            mArgCount++;
-            types++;
+    /**
+     * Register a handler for every message whose address matches a pattern
+     *
+     * All matching handlers are called, in registration order. Messages no
+     * handler matches go to the setCallback() callback, or are counted as
+     * dispatch misses. The pattern is not copied.
+     *
+     *   server.addHandler("/mixer/?/gain", [&mixer](const OSCMessageView& msg) { ... });
+     *
+     * @return false if MAX_HANDLERS handlers are already registered
+     */
+    bool addHandler(const char* pattern, OSCHandler handler)
+    {
+        if (!pattern || !handler || mHandlerCount >= MAX_HANDLERS) return false;
+        mHandlers[mHandlerCount].pattern = pattern;
+        mHandlers[mHandlerCount].handler = handler;
+        mHandlerCount++;
+        return true;
+    }
+
+    /**
+     * Dispatch exact addresses through a compile-time table (see OSCStaticRoutes)
+     * A message found in the table goes only to its static handler.
+     * @return false if the view is not of a valid table; static routing is
+     *         then off (pass OSCStaticRouteView() to turn it off on purpose)
+     */
+    bool setStaticRoutes(const OSCStaticRouteView& routes)
+    {
+        mStaticRoutes = routes.valid ? routes : OSCStaticRouteView();
+        return routes.valid;
+    }
+
+    /**
+     * Remove all typed and message handlers
+     */
+    void clearHandlers()
+    {
+        for (std::size_t i = 0; i < mRouteCount; i++) mRoutes[i].call.reset();
+        for (std::size_t i = 0; i < mHandlerCount; i++) mHandlers[i].handler.reset();
+        mRouteCount = 0;
+        mHandlerCount = 0;
+    }
+
+    /**
+     * Parse every message strictly (see OSCMessageView::setStrict) and
+     * require bundle elements to be 4-byte aligned
+     * Elements of a bundle before a malformed one are still dispatched;
+     * run validateOSCPacket() first for all-or-nothing bundles.
+     */
+    void setStrict(bool strict) { mStrict = strict; }
+
+    /**
+     * Dispatch one complete OSC packet
+     * Bundles are unpacked and each contained message is dispatched.
+     */
+    void processPacket(const char* buffer, std::size_t size)
+    {
+        PICOOSC_TRACE_SCOPE(OSCTraceEvent::Dispatch, size);
+        if (mTap) mTap(buffer, size, mTapUserData);
+        mStats.packetsIn.add();
+        mStats.bytesIn.add(static_cast<uint32_t>(size));
+
+        // Check if this is a bundle
+        if (isOSCBundle(buffer, size)) {
+            mStats.bundlesIn.add();
+            parseBundle(buffer, size);
+        } else if (!coalesce(buffer, size)) {
+            // Single message
+            OSCMessageView msg;
+            dispatchMessage(buffer, size, msg, OSCTimetag::immediate());
         }
+    }
 
-        return true;
+    /**
+     * Observe every packet before it is parsed (nullptr to remove)
+     */
+    void setPacketTap(OSCPacketTap tap, void* userData = nullptr)
+    {
+        mTap = tap;
+        mTapUserData = userData;
     }
 
-    const char* address() const { return mAddress; }
-    const char* typeTags() const { return mTypeTags; }
-    std::size_t argCount() const { return mArgCount; }
+    /**
+     * Keep only the latest message per address until the next poll()
+     * The cache must outlive the dispatcher; nullptr disables coalescing.
+     */
+    void setCoalescer(OSCCoalescer* coalescer) { mCoalescer = coalescer; }
+    OSCCoalescer* coalescer() const { return mCoalescer; }
 
-    const OSCArg* arg(std::size_t index) const
+    /**
+     * Dispatch the latest value of every coalesced address
+     * Call once per tick from the same context as the receive callbacks.
+     * @return Number of messages dispatched
+     */
+    std::size_t poll()
     {
-        return (index < mArgCount) ? &mArgs[index] : nullptr;
+        if (!mCoalescer) return 0;
+        OSCMessageView msg;
+        return mCoalescer->flush(
+            [this, &msg](const char* buffer, std::size_t size) {
+            dispatchMessage(buffer, size, msg, OSCTimetag::immediate());
+        });
     }
 
-    // Convenience accessors
-    int32_t getInt(std::size_t index, int32_t defaultVal = 0) const
+    /**
+     * Snapshot of the receive counters
+     */
+    OSCServerStats stats() const { return mStats.snapshot(); }
+    void resetStats() { mStats.reset(); }
+
+    /**
+     * Accept "/alias" registrations and resolve integer-aliased messages
+     * The table must outlive the dispatcher; nullptr disables aliases.
+     */
+    void setAliasTable(OSCAliasTable* aliases) { mAliases = aliases; }
+    OSCAliasTable* aliasTable() const { return mAliases; }
+
+protected:
+    struct Route
     {
-        const OSCArg* a = arg(index);
-        return (a && a->type == 'i') ? a->i : defaultVal;
+        const char* address = nullptr;
+        const char* tags = nullptr;
+        std::size_t tagCount = 0;
+        OSCInlineFunction<bool(const char* args, const char* end, OSCTimetag timetag)> call;  // Decode and invoke
+    };
+
+    struct Handler
+    {
+        const char* pattern = nullptr;
+        OSCHandler handler;
+    };
+
+    /**
+     * Time a handler call; call() returns false if the handler did not run
+     */
+    template<typename Call>
+    bool runHandler(std::size_t size, Call&& call)
+    {
+        (void)size;
+        PICOOSC_TRACE_SCOPE(OSCTraceEvent::Handler, size);
+#if PICOOSC_STATS && PICOOSC_LATENCY_STATS
+        const uint32_t start = monotonicMicros();
+        const bool ran = call();
+        mStats.handlerLatency.record(monotonicMicros() - start);
+#else
+        const bool ran = call();
+#endif
+        if (ran) mStats.messagesDispatched.add();
+        return ran;
     }
 
-    float getFloat(std::size_t index, float defaultVal = 0.0f) const
+    /**
+     * Match typed handlers on address and type tags without a full parse
+     *
+     * Checks the same bounds and string padding as a lenient parse(). A
+     * message this path cannot decode is left to parse(), which reports
+     * the exact error. Tags must match exactly, so a symbol ('S') does not
+     * match a const char* parameter and falls through to the handlers.
+     * @param timetag Effective timetag passed to handlers that take one
+     * @return true if the message was consumed
+     */
+    bool dispatchRoutes(const char* buffer, std::size_t size, OSCTimetag timetag)
     {
-        const OSCArg* a = arg(index);
-        return (a && a->type == 'f') ? a->f : defaultVal;
+        if (size < 4) return false;
+        const char* end = buffer + size;
+
+        const char* address = nullptr;
+        std::size_t pos = 0;
+        if (buffer[0] == '/') {
+            const void* nul = std::memchr(buffer, '\0', size);
+            if (!nul) return false;
+            address = buffer;
+            const std::size_t length = static_cast<std::size_t>(static_cast<const char*>(nul) - buffer);
+            pos = (length + 4) & ~static_cast<std::size_t>(3);
+            if (!zeroPadding(buffer, length + 1, pos, size)) return false;
+        } else if (buffer[0] == '\0' && mAliases) {
+            address = mAliases->resolve(OSCAliasTable::wireId(buffer));
+            pos = 4;
+        }
+        if (!address) return false;
+
+        const char* tags = "";
+        std::size_t tagCount = 0;
+        if (pos < size && buffer[pos] == ',') {
+            tags = buffer + pos + 1;
+            const void* nul = std::memchr(tags, '\0', static_cast<std::size_t>(end - tags));
+            if (!nul) return false;
+            tagCount = static_cast<std::size_t>(static_cast<const char*>(nul) - tags);
+            const std::size_t tagsEnd = pos + tagCount + 2;
+            pos = (tagsEnd + 3) & ~static_cast<std::size_t>(3);
+            if (!zeroPadding(buffer, tagsEnd, pos, size)) return false;
+        }
+        const char* args = (pos < size) ? buffer + pos : end;
+
+        bool matched = false;
+        for (std::size_t i = 0; i < mRouteCount; i++) {
+            const Route& route = mRoutes[i];
+            if (route.tagCount != tagCount || std::memcmp(route.tags, tags, tagCount) != 0 ||
+                std::strcmp(route.address, address) != 0) {
+                continue;
+            }
+            matched = true;
+
+            // Every matching route decodes the same tags, so a decode
+            // failure can only happen before any handler ran
+            if (!runHandler(size, [&] { return route.call(args, end, timetag); })) return false;
+        }
+        return matched;
     }
 
-    const char* getString(std::size_t index, const char* defaultVal = "") const
+    static bool zeroPadding(const char* buffer, std::size_t from, std::size_t to, std::size_t size)
     {
-        const OSCArg* a = arg(index);
-        return (a && (a->type == 's' || a->type == 'S') && a->s) ? a->s : defaultVal;
+        for (std::size_t i = from; i < to && i < size; i++) {
+            if (buffer[i] != '\0') return false;
+        }
+        return true;
+    }
+
+    /**
+     * @param msg Scratch view, reused across the messages of a packet
+     * @param timetag Effective timetag of the enclosing bundle
+     */
+    void dispatchMessage(const char* buffer, std::size_t size, OSCMessageView& msg, OSCTimetag timetag)
+    {
+        // Typed handlers decode the raw buffer, so strict mode parses first
+        if (!mStrict && mRouteCount > 0 && dispatchRoutes(buffer, size, timetag)) return;
+
+        msg.setStrict(mStrict);
+        if (!msg.parse(buffer, size, mAliases)) {
+            mStats.parseError(msg.error());
+            PICOOSC_LOG_WARN("picoosc: dropped malformed message, reason=%d\n",
+                             static_cast<int>(msg.error()));
+            return;
+        }
+        msg.setTimetag(timetag);
+        if (mStrict && mRouteCount > 0 && dispatchRoutes(buffer, size, timetag)) return;
+        if (mAliases && msg.alias() < 0 &&
+            std::strcmp(msg.address(), OSCAliasTable::ALIAS_ADDRESS) == 0) {
+            registerAliases(msg);
+            return;
+        }
+        if (mStaticRoutes.slots) {
+            const OSCStaticEndpoint* endpoint = mStaticRoutes.find(msg.address(), std::strlen(msg.address()));
+            if (endpoint) {
+                runHandler(size, [&] {
+                    endpoint->handler(msg);
+                    return true;
+                });
+                return;
+            }
+        }
+
+        bool handled = false;
+        for (std::size_t i = 0; i < mHandlerCount; i++) {
+            const Handler& entry = mHandlers[i];
+            if (!msg.matchAddress(entry.pattern)) continue;
+            handled = true;
+            runHandler(size, [&] {
+                entry.handler(msg);
+                return true;
+            });
+        }
+        if (handled) return;
+
+        if (!mCallback) {
+            mStats.dispatchMisses.add();
+            return;
+        }
+
+        runHandler(size, [&] {
+            mCallback(msg, mUserData);
+            return true;
+        });
+    }
+
+    /**
+     * Walk a bundle and dispatch its messages
+     * Nested bundles are tracked on a fixed stack of MAX_BUNDLE_DEPTH frames
+     * instead of by recursion, and one message view is reused for every
+     * element, so stack use does not depend on the packet. Each message
+     * sees the effective timetag of its innermost bundle in timetag().
+     */
+    void parseBundle(const char* buffer, std::size_t size)
+    {
+        OSCMessageView msg;
+        OSCBundleFrame frames[MAX_BUNDLE_DEPTH];
+        std::size_t depth = 0;
+        const char* pos = buffer;
+        const char* end = buffer + size;  // End of the current element
+
+        while (true) {
+            if (isOSCBundle(pos, static_cast<std::size_t>(end - pos))) {
+                if (depth == MAX_BUNDLE_DEPTH) {
+                    mStats.parseError(OSCParseError::BundleTooDeep);
+                    pos = end;
+                } else if (end - pos < 16 || (mStrict && ((end - pos) & 3) != 0)) {
+                    mStats.parseError(OSCParseError::InvalidBundleElement);
+                    pos = end;
+                } else {
+                    bool clamped;
+                    const OSCTimetag timetag = effectiveTimetag(
+                        readBundleTimetag(pos), depth > 0 ? &frames[depth - 1] : nullptr, clamped);
+                    if (clamped && mStrict) {
+                        mStats.parseError(OSCParseError::TimetagOrder);
+                        pos = end;
+                    } else {
+                        if (clamped) mStats.clampedTimetags.add();
+                        frames[depth++] = OSCBundleFrame{end, timetag};
+                        mStats.maxBundleDepth.updateMax(static_cast<uint32_t>(depth));
+                        pos += 16;  // Skip "#bundle\0" (8 bytes) and timetag (8 bytes)
+                    }
+                }
+            } else {
+                dispatchMessage(pos, static_cast<std::size_t>(end - pos), msg,
+                                depth > 0 ? frames[depth - 1].timetag : OSCTimetag::immediate());
+                pos = end;
+            }
+
+            // Find the next element, closing bundles that are done
+            while (depth > 0) {
+                const char* bundleEnd = frames[depth - 1].end;
+                if (bundleEnd - pos < 4) {
+                    depth--;
+                    pos = bundleEnd;
+                    continue;
+                }
+
+                int32_t elemSize;
+                std::memcpy(&elemSize, pos, 4);
+                elemSize = swap_endian(elemSize);
+                if (elemSize <= 0 || elemSize > bundleEnd - pos - 4 || (mStrict && (elemSize & 3) != 0)) {
+                    // Drop the rest of this bundle
+                    mStats.parseError(OSCParseError::InvalidBundleElement);
+                    depth--;
+                    pos = bundleEnd;
+                    continue;
+                }
+                pos += 4;
+                end = pos + elemSize;
+                break;
+            }
+            if (depth == 0) return;
+        }
     }
 
-    bool getBool(std::size_t index, bool defaultVal = false) const
+    bool coalesce(const char* buffer, std::size_t size)
     {
-        const OSCArg* a = arg(index);
-        if (!a) return defaultVal;
-        if (a->type == 'T') return true;
-        if (a->type == 'F') return false;
-        return defaultVal;
+        if (!mCoalescer) return false;
+        // Every alias registration has to be applied, not just the last
+        if (mAliases && size >= 8 && std::memcmp(buffer, OSCAliasTable::ALIAS_ADDRESS, 7) == 0) {
+            return false;
+        }
+
+        bool replaced = false;
+        if (!mCoalescer->store(buffer, size, replaced)) return false;
+        if (replaced) mStats.coalescedMessages.add();
+        return true;
     }
 
     /**
-     * Check if address matches a pattern
-     * Supports basic wildcard: * matches any sequence, ? matches single char
+     * Apply a "/alias" message: (int32 id, string address) pairs
      */
-    bool matchAddress(const char* pattern) const
-    {
-        if (!mAddress || !pattern) return false;
-        return matchPattern(pattern, mAddress);
-    }
-
-private:
-    static constexpr std::size_t MAX_ARGS = 64;
-
-    static bool matchPattern(const char* pattern, const char* str)
+    void registerAliases(const OSCMessageView& msg)
     {
-        while (*pattern && *str) {
-            if (*pattern == '*') {
-                pattern++;
-                if (!*pattern) return true;
-                while (*str) {
-                    if (matchPattern(pattern, str)) return true;
-                    str++;
-                }
-                return false;
-            } else if (*pattern == '?' || *pattern == *str) {
-                pattern++;
-                str++;
-            } else {
-                return false;
+        for (std::size_t i = 0; i + 1 < msg.argCount(); i += 2) {
+            const OSCArg* id = msg.arg(i);
+            const OSCArg* address = msg.arg(i + 1);
+            if (id->type != 'i' || (address->type != 's' && address->type != 'S') ||
+                !mAliases->set(static_cast<uint32_t>(id->i), address->s)) {
+                PICOOSC_LOG_WARN("picoosc: rejected alias registration\n");
             }
         }
-        while (*pattern == '*') pattern++;
-        return !*pattern && !*str;
     }
 
-    const char* mAddress = nullptr;
-    const char* mTypeTags = nullptr;
-    OSCArg mArgs[MAX_ARGS];
-    std::size_t mArgCount = 0;
+    OSCServerCounters mStats;
+    OSCCallback mCallback = nullptr;
+    void* mUserData = nullptr;
+    OSCAliasTable* mAliases = nullptr;
+    OSCCoalescer* mCoalescer = nullptr;
+    OSCPacketTap mTap = nullptr;
+    void* mTapUserData = nullptr;
+    Route mRoutes[MAX_ROUTES];
+    std::size_t mRouteCount = 0;
+    Handler mHandlers[MAX_HANDLERS];
+    std::size_t mHandlerCount = 0;
+    OSCStaticRouteView mStaticRoutes;
+    bool mStrict = false;
 };
 
-/**
- * Callback type for received OSC messages
- */
-using OSCCallback = void (*)(const OSCMessageView& msg, void* userData);
-
 /**
  * OSC Server - listens for incoming OSC messages
  */
-class OSCServer
+class OSCServer : public OSCDispatcher
 {
 public:
     explicit OSCServer(uint16_t port)
@@ -863,6 +4809,21 @@ public:
     OSCServer(const OSCServer&) = delete;
     OSCServer& operator=(const OSCServer&) = delete;
 
+    /**
+     * Restrict the server to one local address instead of IP_ADDR_ANY
+     * Must be called before start(). Leave unset to receive multicast.
+     * @return false if the address is invalid or the server is running
+     */
+    bool setBindAddress(const char* address)
+    {
+        if (mPcb) return false;
+        ip_addr_t addr;
+        if (!ipaddr_aton(address, &addr)) return false;
+        mBindAddr = addr;
+        mHasBindAddr = true;
+        return true;
+    }
+
     /**
      * Start listening for OSC messages
      * @param callback Function to call when a message is received
@@ -873,14 +4834,13 @@ public:
     {
         if (mPcb) return false;  // Already running
 
-        mCallback = callback;
-        mUserData = userData;
+        setCallback(callback, userData);
 
         mPcb = udp_new();
         if (!mPcb) return false;
 
         // Bind to port
-        err_t err = udp_bind(mPcb, IP_ADDR_ANY, mPort);
+        err_t err = udp_bind(mPcb, mHasBindAddr ? &mBindAddr : IP_ADDR_ANY, mPort);
         if (err != ERR_OK) {
             udp_remove(mPcb);
             mPcb = nullptr;
@@ -898,6 +4858,7 @@ public:
      */
     void stop()
     {
+        leaveAllMulticastGroups();
         if (mPcb) {
             udp_remove(mPcb);
             mPcb = nullptr;
@@ -909,6 +4870,68 @@ public:
     bool isRunning() const { return mPcb != nullptr; }
     uint16_t port() const { return mPort; }
 
+    /**
+     * Join an IGMP multicast group (e.g. "239.0.0.1")
+     * @param group Multicast group address
+     * @param interfaceAddress Local interface to join on, nullptr for all
+     * @return false if the address is not multicast, the group table is
+     *         full, or lwIP is built without LWIP_IGMP
+     */
+    bool joinMulticastGroup(const char* group, const char* interfaceAddress = nullptr)
+    {
+#if LWIP_IGMP
+        MulticastGroup entry;
+        if (!ipaddr_aton(group, &entry.group) || !ip_addr_ismulticast(&entry.group)) {
+            return false;
+        }
+        if (interfaceAddress) {
+            if (!ipaddr_aton(interfaceAddress, &entry.interface)) return false;
+        } else {
+            ip_addr_set_zero(&entry.interface);
+        }
+        if (findMulticastGroup(entry) < MAX_MULTICAST_GROUPS) return true;
+        if (mGroupCount >= MAX_MULTICAST_GROUPS) return false;
+
+        if (igmp_joingroup(ip_2_ip4(&entry.interface), ip_2_ip4(&entry.group)) != ERR_OK) {
+            return false;
+        }
+        mGroups[mGroupCount++] = entry;
+        return true;
+#else
+        (void)group;
+        (void)interfaceAddress;
+        return false;
+#endif
+    }
+
+    /**
+     * Leave a multicast group previously joined with joinMulticastGroup()
+     */
+    bool leaveMulticastGroup(const char* group, const char* interfaceAddress = nullptr)
+    {
+#if LWIP_IGMP
+        MulticastGroup entry;
+        if (!ipaddr_aton(group, &entry.group)) return false;
+        if (interfaceAddress) {
+            if (!ipaddr_aton(interfaceAddress, &entry.interface)) return false;
+        } else {
+            ip_addr_set_zero(&entry.interface);
+        }
+        const std::size_t index = findMulticastGroup(entry);
+        if (index >= MAX_MULTICAST_GROUPS) return false;
+
+        igmp_leavegroup(ip_2_ip4(&entry.interface), ip_2_ip4(&entry.group));
+        mGroups[index] = mGroups[--mGroupCount];
+        return true;
+#else
+        (void)group;
+        (void)interfaceAddress;
+        return false;
+#endif
+    }
+
+    std::size_t multicastGroupCount() const { return mGroupCount; }
+
 private:
     static void udpRecvCallback(void* arg, udp_pcb* pcb, pbuf* p,
                                  const ip_addr_t* addr, uint16_t port)
@@ -918,11 +4941,18 @@ private:
         (void)port;
 
         OSCServer* server = static_cast<OSCServer*>(arg);
-        if (!server || !p || !server->mCallback) {
+        if (!server || !p) {
             if (p) pbuf_free(p);
             return;
         }
 
+        PICOOSC_TRACE_SCOPE(OSCTraceEvent::Receive, p->tot_len);
+
+        if (p->tot_len > MAX_MESSAGE_SIZE) {
+            server->mStats.truncatedPackets.add();
+            PICOOSC_LOG_WARN("picoosc: truncated %u byte packet\n", p->tot_len);
+        }
+
         // Copy data from potentially chained pbufs
         char buffer[MAX_MESSAGE_SIZE];
         std::size_t totalLen = 0;
@@ -938,56 +4968,491 @@ private:
 
         pbuf_free(p);
 
-        // Check if this is a bundle
-        if (totalLen >= 8 && std::memcmp(buffer, "#bundle", 7) == 0) {
-            server->parseBundle(buffer, totalLen);
-        } else {
-            // Single message
-            OSCMessageView msg;
-            if (msg.parse(buffer, totalLen)) {
-                server->mCallback(msg, server->mUserData);
+        server->processPacket(buffer, totalLen);
+    }
+
+    struct MulticastGroup
+    {
+        ip_addr_t group;
+        ip_addr_t interface;
+    };
+
+    std::size_t findMulticastGroup(const MulticastGroup& entry) const
+    {
+        for (std::size_t i = 0; i < mGroupCount; i++) {
+            if (ip_addr_cmp(&mGroups[i].group, &entry.group) &&
+                ip_addr_cmp(&mGroups[i].interface, &entry.interface)) {
+                return i;
             }
         }
+        return MAX_MULTICAST_GROUPS;
     }
 
-    void parseBundle(const char* buffer, std::size_t size)
+    void leaveAllMulticastGroups()
+    {
+#if LWIP_IGMP
+        for (std::size_t i = 0; i < mGroupCount; i++) {
+            igmp_leavegroup(ip_2_ip4(&mGroups[i].interface), ip_2_ip4(&mGroups[i].group));
+        }
+#endif
+        mGroupCount = 0;
+    }
+
+    udp_pcb* mPcb = nullptr;
+    uint16_t mPort;
+
+    ip_addr_t mBindAddr{};
+    bool mHasBindAddr = false;
+    MulticastGroup mGroups[MAX_MULTICAST_GROUPS]{};
+    std::size_t mGroupCount = 0;
+};
+
+/**
+ * Incremental decoder for OSC packets carried over a byte stream
+ *
+ * Feed received chunks in order; onPacket(const char* data, std::size_t
+ * size) is called for every complete packet. A packet that lies entirely
+ * within one chunk (and, for SLIP, contains no escape bytes) is passed as a
+ * pointer into the chunk without copying. Otherwise it is reassembled in
+ * the decoder's own buffer. Packets larger than MAX_STREAM_PACKET_SIZE are
+ * skipped and counted in droppedPackets().
+ */
+class OSCStreamDecoder
+{
+public:
+    explicit OSCStreamDecoder(OSCFraming framing = OSCFraming::Slip)
+        : mFraming(framing)
+    {
+    }
+
+    /**
+     * Change the framing; discards any partially received packet
+     */
+    void setFraming(OSCFraming framing)
+    {
+        mFraming = framing;
+        reset();
+    }
+
+    /**
+     * Discard any partially received packet
+     */
+    void reset()
+    {
+        mSize = 0;
+        mHeaderSize = 0;
+        mExpected = 0;
+        mEscape = false;
+        mOverflow = false;
+    }
+
+    template<typename Handler>
+    void feed(const char* data, std::size_t size, Handler&& onPacket)
+    {
+        if (mFraming == OSCFraming::Slip) {
+            feedSlip(data, size, onPacket);
+        } else {
+            feedLengthPrefixed(data, size, onPacket);
+        }
+    }
+
+    /**
+     * Feed a single byte, e.g. one popped from an OSCByteRing
+     * Call it from thread context: onPacket runs the whole dispatch path.
+     * From a UART interrupt, push into an OSCByteRing instead and drain()
+     * it from the main loop.
+     */
+    template<typename Handler>
+    void feedByte(char byte, Handler&& onPacket)
+    {
+        if (mFraming != OSCFraming::Slip) {
+            feedLengthPrefixed(&byte, 1, onPacket);
+            return;
+        }
+
+        const uint8_t c = static_cast<uint8_t>(byte);
+        if (c == SLIP_END) {
+            endFrame(onPacket);
+        } else if (mEscape) {
+            mEscape = false;
+            const char decoded = static_cast<char>(c == SLIP_ESC_END   ? SLIP_END
+                                                   : c == SLIP_ESC_ESC ? SLIP_ESC
+                                                                       : c);
+            append(&decoded, 1);
+        } else if (c == SLIP_ESC) {
+            mEscape = true;
+        } else {
+            append(&byte, 1);
+        }
+    }
+
+    /**
+     * Consume everything currently readable from a ring
+     * Frames that lie contiguously in the ring are dispatched in place.
+     */
+    template<typename Handler>
+    void drain(OSCByteRing& ring, Handler&& onPacket)
     {
-        // Skip "#bundle\0" (8 bytes) and timetag (8 bytes)
-        std::size_t pos = 16;
+        std::size_t size = 0;
+        const char* data = ring.peek(size);
+        while (size > 0) {
+            feed(data, size, onPacket);
+            ring.consume(size);
+            data = ring.peek(size);
+        }
+    }
 
-        while (pos + 4 <= size) {
-            // Read element size
-            int32_t elemSize;
-            std::memcpy(&elemSize, buffer + pos, 4);
-            elemSize = swap_endian(elemSize);
-            pos += 4;
+    OSCFraming framing() const { return mFraming; }
+    std::size_t droppedPackets() const { return mDropped; }
+
+private:
+    template<typename Handler>
+    void feedSlip(const char* data, std::size_t size, Handler& onPacket)
+    {
+        while (size > 0) {
+            if (mEscape) {
+                const uint8_t c = static_cast<uint8_t>(*data++);
+                size--;
+                mEscape = false;
+                if (c == SLIP_END) {
+                    endFrame(onPacket);
+                    continue;
+                }
+                const char decoded = static_cast<char>(c == SLIP_ESC_END   ? SLIP_END
+                                                       : c == SLIP_ESC_ESC ? SLIP_ESC
+                                                                           : c);
+                append(&decoded, 1);
+                continue;
+            }
 
-            if (elemSize <= 0 || pos + static_cast<std::size_t>(elemSize) > size) {
+            const std::size_t run = findSlipSpecial(data, size);
+            if (run == size) {
+                append(data, size);
                 break;
             }
 
-            const char* elemData = buffer + pos;
+            const uint8_t c = static_cast<uint8_t>(data[run]);
 
-            // Check if nested bundle
-            if (static_cast<std::size_t>(elemSize) >= 8 &&
-                std::memcmp(elemData, "#bundle", 7) == 0) {
-                parseBundle(elemData, static_cast<std::size_t>(elemSize));
+            // Fast path: a whole unescaped frame inside this chunk
+            if (c == SLIP_END && mSize == 0 && !mOverflow) {
+                if (run > 0) onPacket(data, run);
             } else {
-                // Parse as message
-                OSCMessageView msg;
-                if (msg.parse(elemData, static_cast<std::size_t>(elemSize))) {
-                    mCallback(msg, mUserData);
+                append(data, run);
+                if (c == SLIP_END) {
+                    endFrame(onPacket);
+                } else {
+                    mEscape = true;
+                }
+            }
+            data += run + 1;
+            size -= run + 1;
+        }
+    }
+
+    template<typename Handler>
+    void feedLengthPrefixed(const char* data, std::size_t size, Handler& onPacket)
+    {
+        while (size > 0) {
+            if (mHeaderSize < 4) {
+                // Fast path: header and whole packet inside this chunk
+                if (mHeaderSize == 0 && size >= 4) {
+                    const std::size_t length = readLength(data);
+                    if (length <= size - 4) {
+                        if (length > 0 && length <= MAX_STREAM_PACKET_SIZE) {
+                            onPacket(data + 4, length);
+                        } else if (length > 0) {
+                            mDropped++;
+                        }
+                        data += 4 + length;
+                        size -= 4 + length;
+                        continue;
+                    }
+                }
+
+                mHeader[mHeaderSize++] = *data++;
+                size--;
+                if (mHeaderSize == 4) {
+                    mExpected = readLength(mHeader);
+                    mSize = 0;
+                    mOverflow = mExpected > MAX_STREAM_PACKET_SIZE;
+                    if (mExpected == 0) mHeaderSize = 0;
+                }
+                continue;
+            }
+
+            std::size_t take = mExpected - mSize;
+            if (take > size) take = size;
+            if (!mOverflow) {
+                std::memcpy(mBuffer + mSize, data, take);
+            }
+            mSize += take;
+            data += take;
+            size -= take;
+
+            if (mSize == mExpected) {
+                if (mOverflow) {
+                    mDropped++;
+                } else {
+                    onPacket(static_cast<const char*>(mBuffer), mSize);
                 }
+                mSize = 0;
+                mHeaderSize = 0;
+                mOverflow = false;
             }
+        }
+    }
 
-            pos += static_cast<std::size_t>(elemSize);
+    template<typename Handler>
+    void endFrame(Handler& onPacket)
+    {
+        if (mOverflow) {
+            mDropped++;
+        } else if (mSize > 0) {
+            onPacket(static_cast<const char*>(mBuffer), mSize);
         }
+        mSize = 0;
+        mEscape = false;
+        mOverflow = false;
     }
 
-    udp_pcb* mPcb = nullptr;
+    void append(const char* data, std::size_t size)
+    {
+        if (mOverflow) return;
+        if (mSize + size > MAX_STREAM_PACKET_SIZE) {
+            mOverflow = true;
+            return;
+        }
+        std::memcpy(mBuffer + mSize, data, size);
+        mSize += size;
+    }
+
+    static std::size_t readLength(const char* data)
+    {
+        uint32_t length;
+        std::memcpy(&length, data, 4);
+        return swap_endian(length);
+    }
+
+    OSCFraming mFraming;
+    char mBuffer[MAX_STREAM_PACKET_SIZE];
+    std::size_t mSize = 0;
+    std::size_t mDropped = 0;
+
+    // Length-prefix state
+    char mHeader[4] = {};
+    std::size_t mHeaderSize = 0;
+    std::size_t mExpected = 0;
+
+    // SLIP state
+    bool mEscape = false;
+    bool mOverflow = false;
+};
+
+#if LWIP_TCP
+/**
+ * OSC Server over TCP - accepts up to MAX_TCP_CONNECTIONS streams
+ *
+ * Every connection gets its own OSCStreamDecoder; complete packets are
+ * dispatched exactly like UDP datagrams. Not movable: lwIP callbacks hold
+ * pointers into the server.
+ */
+class OSCTcpServer : public OSCDispatcher
+{
+public:
+    explicit OSCTcpServer(uint16_t port, OSCFraming framing = OSCFraming::Slip)
+        : mPort(port)
+        , mFraming(framing)
+    {
+    }
+
+    ~OSCTcpServer()
+    {
+        stop();
+    }
+
+    // Non-copyable
+    OSCTcpServer(const OSCTcpServer&) = delete;
+    OSCTcpServer& operator=(const OSCTcpServer&) = delete;
+
+    /**
+     * Start listening for OSC streams
+     * @param callback Function to call when a message is received
+     * @param userData User data passed to callback
+     * @return true on success
+     */
+    bool start(OSCCallback callback, void* userData = nullptr)
+    {
+        if (mListenPcb) return false;  // Already running
+
+        setCallback(callback, userData);
+
+        tcp_pcb* pcb = tcp_new();
+        if (!pcb) return false;
+
+        if (tcp_bind(pcb, IP_ADDR_ANY, mPort) != ERR_OK) {
+            tcp_abort(pcb);
+            return false;
+        }
+
+        // tcp_listen frees pcb and returns a smaller listen pcb
+        mListenPcb = tcp_listen_with_backlog(pcb, MAX_TCP_CONNECTIONS);
+        if (!mListenPcb) {
+            tcp_abort(pcb);
+            return false;
+        }
+
+        tcp_arg(mListenPcb, this);
+        tcp_accept(mListenPcb, &OSCTcpServer::tcpAcceptCallback);
+        return true;
+    }
+
+    /**
+     * Stop listening and close all connections
+     */
+    void stop()
+    {
+        for (Connection& conn : mConnections) {
+            closeConnection(conn);
+        }
+        if (mListenPcb) {
+            tcp_arg(mListenPcb, nullptr);
+            tcp_accept(mListenPcb, nullptr);
+            tcp_close(mListenPcb);
+            mListenPcb = nullptr;
+        }
+        mCallback = nullptr;
+        mUserData = nullptr;
+    }
+
+    bool isRunning() const { return mListenPcb != nullptr; }
+    uint16_t port() const { return mPort; }
+    OSCFraming framing() const { return mFraming; }
+
+    std::size_t connectionCount() const
+    {
+        std::size_t count = 0;
+        for (const Connection& conn : mConnections) {
+            if (conn.pcb) count++;
+        }
+        return count;
+    }
+
+private:
+    struct Connection
+    {
+        OSCTcpServer* server = nullptr;
+        tcp_pcb* pcb = nullptr;
+        OSCStreamDecoder decoder;
+        bool inRecv = false;   // Inside tcpRecvCallback for this pcb
+        bool aborted = false;  // Closed by a handler during tcpRecvCallback
+    };
+
+    static err_t tcpAcceptCallback(void* arg, tcp_pcb* pcb, err_t err)
+    {
+        OSCTcpServer* server = static_cast<OSCTcpServer*>(arg);
+        if (err != ERR_OK || !pcb || !server) {
+            return ERR_VAL;
+        }
+
+        for (Connection& conn : server->mConnections) {
+            if (!conn.pcb) {
+                conn.server = server;
+                conn.pcb = pcb;
+                conn.decoder.setFraming(server->mFraming);
+
+                tcp_arg(pcb, &conn);
+                tcp_recv(pcb, &OSCTcpServer::tcpRecvCallback);
+                tcp_err(pcb, &OSCTcpServer::tcpErrCallback);
+                tcp_nagle_disable(pcb);
+                return ERR_OK;
+            }
+        }
+
+        // No free connection slot
+        PICOOSC_LOG_WARN("picoosc: refused TCP connection, all slots in use\n");
+        tcp_abort(pcb);
+        return ERR_ABRT;
+    }
+
+    static err_t tcpRecvCallback(void* arg, tcp_pcb* pcb, pbuf* p, err_t err)
+    {
+        (void)err;
+        Connection* conn = static_cast<Connection*>(arg);
+
+        if (!p) {
+            // Remote side closed the connection
+            if (conn) {
+                closeConnection(*conn);
+            } else {
+                tcp_close(pcb);
+            }
+            return ERR_OK;
+        }
+
+        PICOOSC_TRACE_SCOPE(OSCTraceEvent::Receive, p->tot_len);
+        if (conn) {
+            // Walk the pbuf chain in place; the decoder only copies packets
+            // that straddle pbuf boundaries. A handler may close this
+            // connection (e.g. via stop()), after which the rest is dropped.
+            OSCTcpServer* server = conn->server;
+            const std::size_t dropped = conn->decoder.droppedPackets();
+            conn->inRecv = true;
+            for (pbuf* q = p; q != nullptr && conn->pcb; q = q->next) {
+                conn->decoder.feed(static_cast<const char*>(q->payload), q->len,
+                                   [conn, server](const char* data, std::size_t size) {
+                                       if (conn->pcb) server->processPacket(data, size);
+                                   });
+            }
+            conn->inRecv = false;
+            server->mStats.truncatedPackets.add(
+                static_cast<uint32_t>(conn->decoder.droppedPackets() - dropped));
+
+            if (conn->aborted) {
+                // The pcb is gone; lwIP must not touch it again
+                conn->aborted = false;
+                pbuf_free(p);
+                return ERR_ABRT;
+            }
+        }
+
+        tcp_recved(pcb, p->tot_len);
+        pbuf_free(p);
+        return ERR_OK;
+    }
+
+    static void tcpErrCallback(void* arg, err_t err)
+    {
+        (void)err;
+        // lwIP has already freed the pcb
+        Connection* conn = static_cast<Connection*>(arg);
+        if (conn) {
+            conn->pcb = nullptr;
+        }
+    }
+
+    static void closeConnection(Connection& conn)
+    {
+        if (!conn.pcb) return;
+
+        tcp_arg(conn.pcb, nullptr);
+        tcp_recv(conn.pcb, nullptr);
+        tcp_err(conn.pcb, nullptr);
+        if (conn.inRecv) {
+            // Closing from inside the recv callback: abort, so the callback
+            // can report ERR_ABRT instead of acknowledging on a dead pcb
+            tcp_abort(conn.pcb);
+            conn.aborted = true;
+        } else if (tcp_close(conn.pcb) != ERR_OK) {
+            tcp_abort(conn.pcb);
+        }
+        conn.pcb = nullptr;
+    }
+
+    tcp_pcb* mListenPcb = nullptr;
     uint16_t mPort;
-    OSCCallback mCallback = nullptr;
-    void* mUserData = nullptr;
+    OSCFraming mFraming;
+    Connection mConnections[MAX_TCP_CONNECTIONS];
 };
+#endif
 
 }  // namespace picoosc
\ No newline at end of file
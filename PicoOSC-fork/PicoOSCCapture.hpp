@@ -0,0 +1,854 @@
+#pragma once
+
+/**
+ * PicoOSC packet capture and replay (host only)
+ *
+ * Records the raw packets seen by an OSCDispatcher into a compact,
+ * append-only log and feeds them back through parse/dispatch later, at
+ * the original pace, scaled, or as fast as possible. pcap and pcapng
+ * files (e.g. Wireshark captures) can be read and written as well.
+ *
+ * File layout (little-endian, every block 8-byte aligned):
+ *   OSCCaptureHeader                      32 bytes
+ *   records:  OSCCaptureRecord + payload  padded to 8 bytes
+ *   index:    uint64_t offset per record  written by close()
+ *
+ * The header's indexOffset stays 0 until close(), so a log cut short by a
+ * crash is still readable by scanning the records. Readers mmap the file
+ * and hand out pointers into the mapping; nothing is copied.
+ *
+ * Requires POSIX (mmap) and a C++17 hosted standard library.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "PicoOSC.hpp"
+
+namespace picoosc
+{
+
+static constexpr char CAPTURE_MAGIC[8] = {'O', 'S', 'C', 'C', 'A', 'P', '0', '1'};
+static constexpr uint32_t CAPTURE_VERSION = 1;
+
+struct OSCCaptureHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t indexOffset;  // 0 if the log was not closed cleanly
+    uint64_t recordCount;
+};
+
+struct OSCCaptureRecord
+{
+    uint64_t timestampUs;  // Microseconds since the first record
+    uint32_t size;         // Payload bytes (without padding)
+    uint32_t reserved;
+};
+
+static_assert(sizeof(OSCCaptureHeader) == 32, "Unexpected capture header size");
+static_assert(sizeof(OSCCaptureRecord) == 16, "Unexpected capture record size");
+
+/**
+ * One captured packet; data points into the reader's mapping
+ */
+struct OSCCapturedPacket
+{
+    uint64_t timestampUs;
+    const char* data;
+    std::size_t size;
+};
+
+/**
+ * Append-only capture log writer
+ *
+ * Usage:
+ *   OSCCaptureWriter capture;
+ *   capture.open("show.osccap");
+ *   server.setPacketTap(OSCCaptureWriter::tap, &capture);
+ *   ...
+ *   capture.close();
+ */
+class OSCCaptureWriter
+{
+public:
+    OSCCaptureWriter() = default;
+    ~OSCCaptureWriter() { close(); }
+
+    OSCCaptureWriter(const OSCCaptureWriter&) = delete;
+    OSCCaptureWriter& operator=(const OSCCaptureWriter&) = delete;
+
+    bool open(const char* path)
+    {
+        close();
+        mFile = std::fopen(path, "wb");
+        if (!mFile) return false;
+
+        OSCCaptureHeader header = {};
+        std::memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+        header.version = CAPTURE_VERSION;
+        mOffset = sizeof(header);
+        mIndex.clear();
+        mStarted = false;
+        return std::fwrite(&header, sizeof(header), 1, mFile) == 1;
+    }
+
+    /**
+     * Append a packet stamped with the current time
+     */
+    bool write(const char* data, std::size_t size)
+    {
+        const uint64_t now = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+        if (!mStarted) {
+            mStart = now;
+            mStarted = true;
+        }
+        return write(data, size, now - mStart);
+    }
+
+    /**
+     * Append a packet with an explicit timestamp (microseconds)
+     */
+    bool write(const char* data, std::size_t size, uint64_t timestampUs)
+    {
+        if (!mFile || size > UINT32_MAX) return false;
+
+        OSCCaptureRecord record = {};
+        record.timestampUs = timestampUs;
+        record.size = static_cast<uint32_t>(size);
+
+        static const char padding[8] = {};
+        const std::size_t padded = (size + 7) & ~static_cast<std::size_t>(7);
+        if (std::fwrite(&record, sizeof(record), 1, mFile) != 1 ||
+            std::fwrite(data, 1, size, mFile) != size ||
+            std::fwrite(padding, 1, padded - size, mFile) != padded - size) {
+            return false;
+        }
+
+        mIndex.push_back(mOffset);
+        mOffset += sizeof(record) + padded;
+        return true;
+    }
+
+    /**
+     * Write the index and finalize the header
+     */
+    bool close()
+    {
+        if (!mFile) return true;
+
+        bool ok = std::fwrite(mIndex.data(), sizeof(uint64_t), mIndex.size(), mFile) == mIndex.size();
+
+        OSCCaptureHeader header = {};
+        std::memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+        header.version = CAPTURE_VERSION;
+        header.indexOffset = mOffset;
+        header.recordCount = mIndex.size();
+        ok = ok && std::fseek(mFile, 0, SEEK_SET) == 0 &&
+             std::fwrite(&header, sizeof(header), 1, mFile) == 1;
+
+        ok = (std::fclose(mFile) == 0) && ok;
+        mFile = nullptr;
+        return ok;
+    }
+
+    bool isOpen() const { return mFile != nullptr; }
+    std::size_t recordCount() const { return mIndex.size(); }
+
+    /**
+     * OSCPacketTap adapter: pass the writer as userData
+     */
+    static void tap(const char* data, std::size_t size, void* userData)
+    {
+        static_cast<OSCCaptureWriter*>(userData)->write(data, size);
+    }
+
+private:
+    std::FILE* mFile = nullptr;
+    std::vector<uint64_t> mIndex;
+    uint64_t mOffset = 0;
+    uint64_t mStart = 0;
+    bool mStarted = false;
+};
+
+/**
+ * Read-only memory map of a whole file
+ */
+class OSCMappedFile
+{
+public:
+    OSCMappedFile() = default;
+    ~OSCMappedFile() { close(); }
+
+    OSCMappedFile(const OSCMappedFile&) = delete;
+    OSCMappedFile& operator=(const OSCMappedFile&) = delete;
+
+    bool open(const char* path)
+    {
+        close();
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) return false;
+
+        ::madvise(data, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+        mData = static_cast<const char*>(data);
+        mSize = static_cast<std::size_t>(st.st_size);
+        return true;
+    }
+
+    void close()
+    {
+        if (mData) ::munmap(const_cast<char*>(mData), mSize);
+        mData = nullptr;
+        mSize = 0;
+    }
+
+    const char* data() const { return mData; }
+    std::size_t size() const { return mSize; }
+
+private:
+    const char* mData = nullptr;
+    std::size_t mSize = 0;
+};
+
+/**
+ * Capture log reader
+ *
+ * Uses the index when the log was closed cleanly and falls back to a
+ * sequential scan otherwise.
+ */
+class OSCCaptureReader
+{
+public:
+    bool open(const char* path)
+    {
+        mCount = 0;
+        mIndex = nullptr;
+        mEnd = 0;
+        if (!mFile.open(path)) return false;
+        if (mFile.size() < sizeof(OSCCaptureHeader)) {
+            mFile.close();
+            return false;
+        }
+
+        OSCCaptureHeader header;
+        std::memcpy(&header, mFile.data(), sizeof(header));
+        if (std::memcmp(header.magic, CAPTURE_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != CAPTURE_VERSION) {
+            mFile.close();
+            return false;
+        }
+
+        // Header fields are untrusted: compare without sums or products
+        // that could wrap
+        const uint64_t fileSize = mFile.size();
+        if (header.indexOffset >= sizeof(OSCCaptureHeader) && header.indexOffset <= fileSize &&
+            header.indexOffset % sizeof(uint64_t) == 0 &&
+            header.recordCount <= (fileSize - header.indexOffset) / sizeof(uint64_t)) {
+            mIndex = reinterpret_cast<const uint64_t*>(mFile.data() + header.indexOffset);
+            mCount = static_cast<std::size_t>(header.recordCount);
+            mEnd = static_cast<std::size_t>(header.indexOffset);
+        } else {
+            // Unfinished log: count the complete records
+            mEnd = mFile.size();
+            std::size_t offset = sizeof(OSCCaptureHeader);
+            OSCCapturedPacket packet;
+            while (recordAt(offset, packet)) {
+                offset += recordSpan(packet.size);
+                mCount++;
+            }
+            mEnd = offset;
+        }
+        return true;
+    }
+
+    std::size_t size() const { return mCount; }
+
+    /**
+     * Random access through the index (or a scan for unfinished logs)
+     */
+    bool packet(std::size_t i, OSCCapturedPacket& out) const
+    {
+        if (i >= mCount) return false;
+        if (mIndex) {
+            return mIndex[i] <= mEnd && recordAt(static_cast<std::size_t>(mIndex[i]), out);
+        }
+
+        std::size_t offset = sizeof(OSCCaptureHeader);
+        for (std::size_t n = 0; n < i; n++) {
+            if (!recordAt(offset, out)) return false;
+            offset += recordSpan(out.size);
+        }
+        return recordAt(offset, out);
+    }
+
+    /**
+     * Visit every packet in order: handler(const OSCCapturedPacket&)
+     * @return Number of packets visited
+     */
+    template<typename Handler>
+    std::size_t forEach(Handler&& handler) const
+    {
+        std::size_t offset = sizeof(OSCCaptureHeader);
+        std::size_t visited = 0;
+        OSCCapturedPacket packet;
+        while (visited < mCount && recordAt(offset, packet)) {
+            handler(packet);
+            offset += recordSpan(packet.size);
+            visited++;
+        }
+        return visited;
+    }
+
+private:
+    static std::size_t recordSpan(std::size_t size)
+    {
+        return sizeof(OSCCaptureRecord) + ((size + 7) & ~static_cast<std::size_t>(7));
+    }
+
+    bool recordAt(std::size_t offset, OSCCapturedPacket& out) const
+    {
+        if (offset > mEnd || mEnd - offset < sizeof(OSCCaptureRecord)) return false;
+        OSCCaptureRecord record;
+        std::memcpy(&record, mFile.data() + offset, sizeof(record));
+        if (record.size > mEnd - offset - sizeof(record)) return false;
+
+        out.timestampUs = record.timestampUs;
+        out.data = mFile.data() + offset + sizeof(record);
+        out.size = record.size;
+        return true;
+    }
+
+    OSCMappedFile mFile;
+    const uint64_t* mIndex = nullptr;
+    std::size_t mCount = 0;
+    std::size_t mEnd = 0;
+};
+
+/**
+ * Reader for pcap and pcapng files containing UDP OSC traffic
+ *
+ * Walks the mapped file block by block, so large venue captures are never
+ * loaded whole. Supports Ethernet (with VLAN tags), raw IP, BSD loopback
+ * and Linux cooked (SLL/SLL2) link types, IPv4 and IPv6. IP fragments
+ * other than unfragmented datagrams are skipped.
+ *
+ * With a port set, only UDP datagrams sent to that port are returned;
+ * with port 0, any UDP payload that starts like OSC ('/' or "#bundle").
+ * Timestamps are microseconds since the Unix epoch.
+ */
+class OSCPcapReader
+{
+public:
+    bool open(const char* path, uint16_t port = 0)
+    {
+        mPort = port;
+        mFormat = Format::Unknown;
+        if (!mFile.open(path)) return false;
+        if (mFile.size() < 24) {
+            mFile.close();
+            return false;
+        }
+
+        uint32_t magic;
+        std::memcpy(&magic, mFile.data(), 4);
+        if (magic == 0xA1B2C3D4 || magic == 0xA1B23C4D) {
+            mSwap = false;
+        } else if (magic == 0xD4C3B2A1 || magic == 0x4D3CB2A1) {
+            mSwap = true;
+        } else if (magic == 0x0A0D0D0A) {
+            mFormat = Format::PcapNg;
+            return true;
+        } else {
+            mFile.close();
+            return false;
+        }
+
+        mFormat = Format::Pcap;
+        mNanoseconds = (magic == 0xA1B23C4D || magic == 0x4D3CB2A1);
+        mLinkType = read32(20, mSwap);
+        return true;
+    }
+
+    /**
+     * Visit every OSC datagram in order: handler(const OSCCapturedPacket&)
+     * @return Number of datagrams visited
+     */
+    template<typename Handler>
+    std::size_t forEach(Handler&& handler) const
+    {
+        if (mFormat == Format::Pcap) return forEachPcap(handler);
+        if (mFormat == Format::PcapNg) return forEachPcapNg(handler);
+        return 0;
+    }
+
+private:
+    enum class Format
+    {
+        Unknown,
+        Pcap,
+        PcapNg,
+    };
+
+    static constexpr std::size_t MAX_INTERFACES = 16;
+
+    // Per pcapng interface: link type and timestamp resolution
+    struct Interface
+    {
+        uint32_t linkType;
+        uint8_t tsresol;  // if_tsresol option, default 6 (microseconds)
+    };
+
+    template<typename Handler>
+    std::size_t forEachPcap(Handler& handler) const
+    {
+        std::size_t visited = 0;
+        std::size_t offset = 24;
+        while (offset + 16 <= mFile.size()) {
+            const uint32_t seconds = read32(offset, mSwap);
+            const uint32_t fraction = read32(offset + 4, mSwap);
+            const uint32_t captured = read32(offset + 8, mSwap);
+            offset += 16;
+            if (captured > mFile.size() - offset) break;
+
+            const uint64_t us = static_cast<uint64_t>(seconds) * 1000000 +
+                                (mNanoseconds ? fraction / 1000 : fraction);
+            visited += emit(mLinkType, mFile.data() + offset, captured, us, handler);
+            offset += captured;
+        }
+        return visited;
+    }
+
+    template<typename Handler>
+    std::size_t forEachPcapNg(Handler& handler) const
+    {
+        Interface interfaces[MAX_INTERFACES];
+        std::size_t interfaceCount = 0;
+        std::size_t visited = 0;
+        std::size_t offset = 0;
+        bool swap = false;
+
+        while (offset + 12 <= mFile.size()) {
+            uint32_t type;
+            std::memcpy(&type, mFile.data() + offset, 4);
+
+            if (type == 0x0A0D0D0A) {
+                // Section header: byte order magic decides the section's endianness
+                uint32_t byteOrder;
+                std::memcpy(&byteOrder, mFile.data() + offset + 8, 4);
+                swap = (byteOrder == 0x4D3C2B1A);
+                interfaceCount = 0;
+            }
+            type = read32(offset, swap);
+            const uint32_t length = read32(offset + 4, swap);
+            if (length < 12 || length % 4 != 0 || length > mFile.size() - offset) break;
+
+            const std::size_t body = offset + 8;
+            const std::size_t bodyEnd = offset + length - 4;
+
+            if (type == 1 && bodyEnd >= body + 8) {
+                // Interface description
+                if (interfaceCount < MAX_INTERFACES) {
+                    Interface& iface = interfaces[interfaceCount];
+                    iface.linkType = read16(body, swap);
+                    iface.tsresol = 6;
+                    std::size_t option = body + 8;
+                    while (option + 4 <= bodyEnd) {
+                        const uint16_t code = read16(option, swap);
+                        const uint16_t optionLength = read16(option + 2, swap);
+                        if (code == 0 || option + 4 + optionLength > bodyEnd) break;
+                        if (code == 9 && optionLength >= 1) {
+                            iface.tsresol = static_cast<uint8_t>(mFile.data()[option + 4]);
+                        }
+                        option += 4 + ((optionLength + 3u) & ~3u);
+                    }
+                }
+                interfaceCount++;
+            } else if (type == 6 && bodyEnd >= body + 20) {
+                // Enhanced packet
+                const uint32_t id = read32(body, swap);
+                const uint64_t timestamp =
+                    (static_cast<uint64_t>(read32(body + 4, swap)) << 32) | read32(body + 8, swap);
+                const uint32_t captured = read32(body + 12, swap);
+                if (id < interfaceCount && id < MAX_INTERFACES && captured <= bodyEnd - (body + 20)) {
+                    visited += emit(interfaces[id].linkType, mFile.data() + body + 20, captured,
+                                    toMicros(timestamp, interfaces[id].tsresol), handler);
+                }
+            } else if (type == 3 && bodyEnd >= body + 4 && interfaceCount > 0) {
+                // Simple packet: no timestamp, always interface 0
+                uint32_t captured = read32(body, swap);
+                if (captured > bodyEnd - (body + 4)) captured = static_cast<uint32_t>(bodyEnd - (body + 4));
+                visited += emit(interfaces[0].linkType, mFile.data() + body + 4, captured, 0, handler);
+            }
+            offset += length;
+        }
+        return visited;
+    }
+
+    /**
+     * Convert a pcapng timestamp in if_tsresol units to microseconds
+     */
+    static uint64_t toMicros(uint64_t timestamp, uint8_t tsresol)
+    {
+        const uint8_t exponent = tsresol & 0x7F;
+        if (tsresol & 0x80) {
+            // Negative power of two
+            if (exponent >= 64) return 0;
+            const uint64_t mask = (exponent == 0) ? 0 : ((uint64_t{1} << exponent) - 1);
+            return (timestamp >> exponent) * 1000000 + (((timestamp & mask) * 1000000) >> exponent);
+        }
+        uint64_t us = timestamp;
+        for (uint8_t e = exponent; e > 6; e--) us /= 10;
+        for (uint8_t e = exponent; e < 6; e++) us *= 10;
+        return us;
+    }
+
+    /**
+     * Strip link, IP and UDP headers and hand an OSC payload to the handler
+     * @return 1 if the frame was an OSC datagram, 0 otherwise
+     */
+    template<typename Handler>
+    std::size_t emit(uint32_t linkType, const char* frame, std::size_t size, uint64_t us,
+                     Handler& handler) const
+    {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(frame);
+        std::size_t pos = 0;
+
+        switch (linkType) {
+            case 1: {  // Ethernet
+                if (size < 14) return 0;
+                uint16_t etherType = be16(p + 12);
+                pos = 14;
+                while ((etherType == 0x8100 || etherType == 0x88A8) && pos + 4 <= size) {
+                    etherType = be16(p + pos + 2);
+                    pos += 4;
+                }
+                if (etherType != 0x0800 && etherType != 0x86DD) return 0;
+                break;
+            }
+            case 0:    // BSD loopback: 4-byte address family
+            case 108:  // OpenBSD loopback
+                pos = 4;
+                break;
+            case 12:   // Raw IP (some platforms)
+            case 101:  // Raw IP
+            case 228:  // Raw IPv4
+            case 229:  // Raw IPv6
+                break;
+            case 113:  // Linux cooked v1
+                pos = 16;
+                break;
+            case 276:  // Linux cooked v2
+                pos = 20;
+                break;
+            default:
+                return 0;
+        }
+        if (pos >= size) return 0;
+
+        const uint8_t version = p[pos] >> 4;
+        std::size_t udp;
+        if (version == 4) {
+            if (pos + 20 > size) return 0;
+            const std::size_t headerLength = static_cast<std::size_t>(p[pos] & 0x0F) * 4;
+            if (headerLength < 20) return 0;
+            const uint16_t fragment = be16(p + pos + 6);
+            if (p[pos + 9] != 17 || (fragment & 0x3FFF) != 0) return 0;  // UDP, unfragmented
+            udp = pos + headerLength;
+        } else if (version == 6) {
+            if (pos + 40 > size || p[pos + 6] != 17) return 0;  // No extension headers
+            udp = pos + 40;
+        } else {
+            return 0;
+        }
+        if (udp + 8 > size) return 0;
+
+        const uint16_t destination = be16(p + udp + 2);
+        std::size_t payloadSize = be16(p + udp + 4);
+        if (payloadSize < 8) return 0;
+        payloadSize -= 8;
+        if (udp + 8 + payloadSize > size) payloadSize = size - (udp + 8);  // Truncated capture
+
+        const char* payload = frame + udp + 8;
+        if (mPort != 0) {
+            if (destination != mPort) return 0;
+        } else if (payloadSize < 4 ||
+                   (payload[0] != '/' && !isOSCBundle(payload, payloadSize))) {
+            return 0;
+        }
+
+        OSCCapturedPacket packet;
+        packet.timestampUs = us;
+        packet.data = payload;
+        packet.size = payloadSize;
+        handler(packet);
+        return 1;
+    }
+
+    static uint16_t be16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+    uint16_t read16(std::size_t offset, bool swap) const
+    {
+        uint16_t value;
+        std::memcpy(&value, mFile.data() + offset, 2);
+        return swap ? static_cast<uint16_t>((value >> 8) | (value << 8)) : value;
+    }
+
+    uint32_t read32(std::size_t offset, bool swap) const
+    {
+        uint32_t value;
+        std::memcpy(&value, mFile.data() + offset, 4);
+        return swap ? swap_endian(value) : value;
+    }
+
+    OSCMappedFile mFile;
+    Format mFormat = Format::Unknown;
+    bool mSwap = false;  // Classic pcap only; pcapng tracks it per section
+    bool mNanoseconds = false;
+    uint32_t mLinkType = 0;
+    uint16_t mPort = 0;
+};
+
+/**
+ * Writer for pcap or pcapng files
+ *
+ * Each packet is wrapped in synthetic IPv4 and UDP headers (raw IP link
+ * type), so Wireshark decodes it as OSC on the configured port.
+ *
+ * Usage:
+ *   OSCPcapWriter pcap;
+ *   pcap.open("session.pcapng", OSCPcapWriter::PcapNg);
+ *   server.setPacketTap(OSCPcapWriter::tap, &pcap);
+ */
+class OSCPcapWriter
+{
+public:
+    enum Format
+    {
+        Pcap,
+        PcapNg,
+    };
+
+    OSCPcapWriter() = default;
+    ~OSCPcapWriter() { close(); }
+
+    OSCPcapWriter(const OSCPcapWriter&) = delete;
+    OSCPcapWriter& operator=(const OSCPcapWriter&) = delete;
+
+    /**
+     * Addresses and ports written into the synthetic headers
+     * @param sourceIp, destinationIp IPv4 addresses in host byte order
+     */
+    void setEndpoints(uint32_t sourceIp, uint16_t sourcePort, uint32_t destinationIp, uint16_t destinationPort)
+    {
+        mSourceIp = sourceIp;
+        mSourcePort = sourcePort;
+        mDestinationIp = destinationIp;
+        mDestinationPort = destinationPort;
+    }
+
+    bool open(const char* path, Format format = Pcap)
+    {
+        close();
+        mFile = std::fopen(path, "wb");
+        if (!mFile) return false;
+        mFormat = format;
+
+        if (format == Pcap) {
+            const uint32_t header[6] = {0xA1B2C3D4, 0x00040002, 0, 0, 65535, LINKTYPE_RAW};
+            return std::fwrite(header, sizeof(header), 1, mFile) == 1;
+        }
+
+        // Section header block, then one interface description block
+        const uint32_t section[7] = {0x0A0D0D0A, 28, 0x1A2B3C4D, 0x00000001, 0xFFFFFFFF, 0xFFFFFFFF, 28};
+        const uint32_t interface[5] = {1, 20, LINKTYPE_RAW, 65535, 20};
+        return std::fwrite(section, sizeof(section), 1, mFile) == 1 &&
+               std::fwrite(interface, sizeof(interface), 1, mFile) == 1;
+    }
+
+    /**
+     * Append a packet stamped with the current wall-clock time
+     */
+    bool write(const char* data, std::size_t size)
+    {
+        const uint64_t now = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch())
+                .count());
+        return write(data, size, now);
+    }
+
+    /**
+     * Append a packet with an explicit timestamp (microseconds since the epoch)
+     */
+    bool write(const char* data, std::size_t size, uint64_t timestampUs)
+    {
+        if (!mFile || size > 65535 - 28) return false;
+
+        uint8_t headers[28];
+        const std::size_t frameSize = sizeof(headers) + size;
+        buildHeaders(headers, size);
+
+        static const char padding[4] = {};
+        const std::size_t padded = (frameSize + 3) & ~static_cast<std::size_t>(3);
+        bool ok;
+        if (mFormat == Pcap) {
+            const uint32_t record[4] = {static_cast<uint32_t>(timestampUs / 1000000),
+                                        static_cast<uint32_t>(timestampUs % 1000000),
+                                        static_cast<uint32_t>(frameSize), static_cast<uint32_t>(frameSize)};
+            ok = std::fwrite(record, sizeof(record), 1, mFile) == 1;
+            ok = ok && std::fwrite(headers, sizeof(headers), 1, mFile) == 1;
+            ok = ok && std::fwrite(data, 1, size, mFile) == size;
+        } else {
+            const uint32_t blockLength = static_cast<uint32_t>(28 + padded + 4);
+            const uint32_t block[7] = {6,
+                                       blockLength,
+                                       0,
+                                       static_cast<uint32_t>(timestampUs >> 32),
+                                       static_cast<uint32_t>(timestampUs),
+                                       static_cast<uint32_t>(frameSize),
+                                       static_cast<uint32_t>(frameSize)};
+            ok = std::fwrite(block, sizeof(block), 1, mFile) == 1;
+            ok = ok && std::fwrite(headers, sizeof(headers), 1, mFile) == 1;
+            ok = ok && std::fwrite(data, 1, size, mFile) == size;
+            ok = ok && std::fwrite(padding, 1, padded - frameSize, mFile) == padded - frameSize;
+            ok = ok && std::fwrite(&blockLength, 4, 1, mFile) == 1;
+        }
+        return ok;
+    }
+
+    bool close()
+    {
+        if (!mFile) return true;
+        const bool ok = std::fclose(mFile) == 0;
+        mFile = nullptr;
+        return ok;
+    }
+
+    bool isOpen() const { return mFile != nullptr; }
+
+    /**
+     * OSCPacketTap adapter: pass the writer as userData
+     */
+    static void tap(const char* data, std::size_t size, void* userData)
+    {
+        static_cast<OSCPcapWriter*>(userData)->write(data, size);
+    }
+
+private:
+    static constexpr uint32_t LINKTYPE_RAW = 101;
+
+    void buildHeaders(uint8_t* h, std::size_t size) const
+    {
+        const std::size_t total = 28 + size;
+        const std::size_t udpLength = 8 + size;
+
+        // IPv4, no options, TTL 64, UDP
+        h[0] = 0x45;
+        h[1] = 0;
+        put16(h + 2, static_cast<uint16_t>(total));
+        put16(h + 4, 0);
+        put16(h + 6, 0x4000);  // Don't fragment
+        h[8] = 64;
+        h[9] = 17;
+        put16(h + 10, 0);
+        put32(h + 12, mSourceIp);
+        put32(h + 16, mDestinationIp);
+
+        uint32_t sum = 0;
+        for (std::size_t i = 0; i < 20; i += 2) sum += static_cast<uint32_t>((h[i] << 8) | h[i + 1]);
+        while (sum >> 16) sum = (sum & 0xFFFF) + (sum >> 16);
+        put16(h + 10, static_cast<uint16_t>(~sum));
+
+        // UDP, checksum 0 (not computed, allowed for IPv4)
+        put16(h + 20, mSourcePort);
+        put16(h + 22, mDestinationPort);
+        put16(h + 24, static_cast<uint16_t>(udpLength));
+        put16(h + 26, 0);
+    }
+
+    static void put16(uint8_t* p, uint16_t value)
+    {
+        p[0] = static_cast<uint8_t>(value >> 8);
+        p[1] = static_cast<uint8_t>(value);
+    }
+
+    static void put32(uint8_t* p, uint32_t value)
+    {
+        put16(p, static_cast<uint16_t>(value >> 16));
+        put16(p + 2, static_cast<uint16_t>(value));
+    }
+
+    std::FILE* mFile = nullptr;
+    Format mFormat = Pcap;
+    uint32_t mSourceIp = 0x7F000001;       // 127.0.0.1
+    uint32_t mDestinationIp = 0x7F000001;
+    uint16_t mSourcePort = 57120;
+    uint16_t mDestinationPort = 9000;
+};
+
+/**
+ * Feed captured packets back through a dispatcher
+ *
+ * A packet stamped earlier than the one before it (out-of-order pcap
+ * records, a clock step, or a pcapng Simple Packet Block, which carries
+ * no timestamp) is replayed right after its predecessor; the schedule
+ * never runs backwards. Offsets are capped at one year.
+ *
+ * @param source OSCCaptureReader or OSCPcapReader
+ * @param speed 1.0 replays at the original pace, 2.0 twice as fast,
+ *              0 (or less) as fast as possible
+ * @return Number of packets replayed
+ */
+template<typename Source>
+std::size_t replayCapture(const Source& source, OSCDispatcher& dispatcher, double speed = 1.0)
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr double MAX_OFFSET_US = 365.0 * 24 * 3600 * 1000000;
+    const Clock::time_point start = Clock::now();
+    bool first = true;
+    uint64_t origin = 0;
+    double previousUs = 0.0;
+
+    return source.forEach([&](const OSCCapturedPacket& packet) {
+        if (speed > 0.0) {
+            if (first) {
+                origin = packet.timestampUs;
+                first = false;
+            }
+            // Signed distance from the first packet, without wrapping
+            const double deltaUs = packet.timestampUs >= origin
+                                       ? static_cast<double>(packet.timestampUs - origin)
+                                       : -static_cast<double>(origin - packet.timestampUs);
+            double offsetUs = deltaUs / speed;
+            if (!(offsetUs >= previousUs)) offsetUs = previousUs;  // Also catches NaN
+            if (offsetUs > MAX_OFFSET_US) offsetUs = MAX_OFFSET_US;
+            previousUs = offsetUs;
+            std::this_thread::sleep_until(
+                start + std::chrono::microseconds(static_cast<int64_t>(offsetUs)));
+        }
+        dispatcher.processPacket(packet.data, packet.size);
+    });
+}
+
+}  // namespace picoosc
@@ -0,0 +1,202 @@
+// Host benchmarks for the PicoOSC encoder, decoder and dispatch path.
+//
+// Build with -DPICOOSC_BUILD_BENCH=ON and run:
+//   ./PicoOSC_bench [iterations]
+//
+// lwIP is replaced by lwip_stub, which delivers UDP datagrams to the bound
+// server synchronously, so the end-to-end numbers cover build, pbuf copy,
+// receive, parse and dispatch but no real network.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "PicoOSC.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr uint16_t benchPort = 9000;
+
+template<typename T>
+void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Shape
+{
+  const char* name;
+  void (*fill)(picoosc::OSCMessage& msg);
+};
+
+void fillFloat(picoosc::OSCMessage& msg)
+{
+  msg.setAddress("/mixer/channel/12/fader");
+  msg.addFloat(0.75f);
+}
+
+void fillMixed(picoosc::OSCMessage& msg)
+{
+  msg.setAddress("/synth/voice/3/note");
+  msg.addInt(60);
+  msg.addFloat(0.8f);
+  msg.addString("piano");
+  msg.addTrue();
+}
+
+void fillStrings(picoosc::OSCMessage& msg)
+{
+  msg.setAddress("/show/cue/label");
+  msg.addString("Act 2 Scene 4");
+  msg.addString("house lights down to 10 percent");
+  msg.addString("follow spot on stage left");
+  msg.addString("go");
+}
+
+void fillBlob(picoosc::OSCMessage& msg)
+{
+  static uint8_t blob[256];
+  for (std::size_t i = 0; i < sizeof(blob); i++) {
+    blob[i] = static_cast<uint8_t>(i);
+  }
+  msg.setAddress("/synth/waveform");
+  msg.addBlob(blob, sizeof(blob));
+}
+
+const Shape shapes[] = {
+    {"1 float", fillFloat},
+    {"int,float,string,true", fillMixed},
+    {"4 strings", fillStrings},
+    {"256 byte blob", fillBlob},
+};
+
+void report(const char* what, const char* shape, std::size_t iterations, Clock::duration elapsed)
+{
+  const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  const double nsPerOp = ns / static_cast<double>(iterations);
+  std::printf("%-22s %-24s %10.1f ns/op %14.0f msgs/s\n", what, shape, nsPerOp, 1e9 / nsPerOp);
+}
+
+template<typename Fn>
+void run(const char* what, const char* shape, std::size_t iterations, Fn&& fn)
+{
+  for (std::size_t i = 0; i < iterations / 10; i++) {
+    fn();
+  }
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < iterations; i++) {
+    fn();
+  }
+  report(what, shape, iterations, Clock::now() - start);
+}
+
+std::size_t received = 0;
+
+void onMessage(const picoosc::OSCMessageView& msg, void* userData)
+{
+  (void)userData;
+  doNotOptimize(msg.argCount());
+  received++;
+}
+
+void latency(const char* shape, const picoosc::OSCMessage& msg, std::size_t iterations)
+{
+  picoosc::OSCServer server(benchPort);
+  picoosc::OSCClient client("127.0.0.1", benchPort);
+  if (!server.start(onMessage, nullptr)) {
+    std::printf("loopback %-24s failed to start server\n", shape);
+    return;
+  }
+
+  std::vector<int64_t> samples(iterations);
+  received = 0;
+  for (std::size_t i = 0; i < iterations; i++) {
+    const auto start = Clock::now();
+    msg.send(client);
+    samples[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+  }
+  if (received != iterations) {
+    std::printf("loopback %-24s lost %zu packets\n", shape, iterations - received);
+  }
+
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&](double p) {
+    return samples[std::min(samples.size() - 1, static_cast<std::size_t>(p * static_cast<double>(samples.size())))];
+  };
+  std::printf("%-22s %-24s p50 %6lld ns  p90 %6lld ns  p99 %6lld ns  p99.9 %6lld ns  max %7lld ns\n",
+              "loopback latency",
+              shape,
+              static_cast<long long>(percentile(0.50)),
+              static_cast<long long>(percentile(0.90)),
+              static_cast<long long>(percentile(0.99)),
+              static_cast<long long>(percentile(0.999)),
+              static_cast<long long>(samples.back()));
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const std::size_t iterations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+  if (iterations == 0) {
+    std::fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  for (const Shape& shape : shapes) {
+    picoosc::OSCMessage msg;
+    shape.fill(msg);
+
+    char buffer[picoosc::MAX_MESSAGE_SIZE];
+    const std::size_t size = msg.build(buffer, sizeof(buffer));
+
+    run("OSCMessage::build", shape.name, iterations, [&] {
+      doNotOptimize(msg.build(buffer, sizeof(buffer)));
+    });
+
+    picoosc::OSCMessageView view;
+    run("parse (lenient)", shape.name, iterations, [&] {
+      doNotOptimize(view.parse(buffer, size));
+    });
+
+    picoosc::OSCMessageView strictView;
+    strictView.setStrict(true);
+    run("parse (strict)", shape.name, iterations, [&] {
+      doNotOptimize(strictView.parse(buffer, size));
+    });
+
+    picoosc::OSCBundle bundle;
+    run("OSCBundle::addMessage", shape.name, iterations, [&] {
+      if (!bundle.addMessage(msg)) {
+        bundle.clear();
+      }
+      doNotOptimize(bundle.size());
+    });
+
+    latency(shape.name, msg, iterations);
+  }
+
+  picoosc::OSCMessage msg;
+  msg.setAddress("/mixer/channel/12/fader");
+  char buffer[picoosc::MAX_MESSAGE_SIZE];
+  picoosc::OSCMessageView view;
+  view.parse(buffer, msg.build(buffer, sizeof(buffer)));
+
+  run("matchAddress", "exact", iterations, [&] {
+    doNotOptimize(view.matchAddress("/mixer/channel/12/fader"));
+  });
+  run("matchAddress", "'*' wildcard", iterations, [&] {
+    doNotOptimize(view.matchAddress("/mixer/*/fader"));
+  });
+  run("matchAddress", "'?' wildcard", iterations, [&] {
+    doNotOptimize(view.matchAddress("/mixer/channel/1?/fader"));
+  });
+  run("matchAddress", "mismatch", iterations, [&] {
+    doNotOptimize(view.matchAddress("/mixer/channel/12/mute"));
+  });
+
+  return 0;
+}
@@ -0,0 +1,138 @@
+// libFuzzer target for the OSC message and bundle parsers.
+//
+//   cmake -S . -B build-fuzz -DCMAKE_CXX_COMPILER=clang++ -DPICOOSC_BUILD_FUZZ=ON
+//   cmake --build build-fuzz --target PicoOSC_fuzz
+//   ./build-fuzz/bench/PicoOSC_fuzz -max_len=1024 bench/fuzz_corpus
+//
+// Every input goes through validateOSCPacket(), a lenient and a strict
+// OSCMessageView, and a lenient and a strict OSCDispatcher, and every
+// parsed argument is read back so ASan sees any out-of-bounds view. With
+// compilers other than clang the target is built with a small driver that
+// runs each file or directory given on the command line once, so the
+// corpus doubles as a regression suite.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "PicoOSC.hpp"
+
+#if !defined(PICOOSC_LIBFUZZER)
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#endif
+
+namespace
+{
+volatile uint32_t sink;
+
+void touchArgs(const picoosc::OSCMessageView& msg)
+{
+  uint32_t sum = static_cast<uint32_t>(std::strlen(msg.address())) +
+                 static_cast<uint32_t>(std::strlen(msg.typeTags()));
+  for (std::size_t i = 0; i < msg.argCount(); i++) {
+    const picoosc::OSCArg* arg = msg.arg(i);
+    if (arg->s) sum += static_cast<uint32_t>(std::strlen(arg->s));
+    for (int32_t j = 0; arg->blobData && j < arg->blobSize; j++) sum += arg->blobData[j];
+    sum += static_cast<uint32_t>(msg.getInt(i)) + static_cast<uint32_t>(msg.getDouble(i));
+  }
+  sink = sink + sum;
+}
+
+void touchCallback(const picoosc::OSCMessageView& msg, void* userData)
+{
+  (void)userData;
+  touchArgs(msg);
+}
+
+picoosc::OSCDispatcher& dispatcher(bool strict)
+{
+  static picoosc::OSCDispatcher dispatchers[2];
+  static bool initialized = false;
+  if (!initialized) {
+    for (picoosc::OSCDispatcher& d : dispatchers) {
+      d.setCallback(touchCallback, nullptr);
+      d.on<int32_t, const char*, picoosc::OSCBlob>(
+          "/fuzz", [](int32_t i, const char* s, picoosc::OSCBlob b) {
+            uint32_t sum = static_cast<uint32_t>(i) + static_cast<uint32_t>(std::strlen(s));
+            for (int32_t j = 0; j < b.size; j++) sum += b.data[j];
+            sink = sink + sum;
+          });
+    }
+    dispatchers[1].setStrict(true);
+    initialized = true;
+  }
+  return dispatchers[strict ? 1 : 0];
+}
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  // An exactly sized copy, so reading one byte past the packet is caught
+  std::unique_ptr<char[]> packet(new char[size > 0 ? size : 1]);
+  if (size > 0) std::memcpy(packet.get(), data, size);
+  const char* buffer = packet.get();
+
+  const picoosc::OSCParseError strictError = picoosc::validateOSCPacket(buffer, size);
+  const bool isBundle = picoosc::isOSCBundle(buffer, size);
+
+  picoosc::OSCMessageView lenient;
+  const bool lenientOk = lenient.parse(buffer, size);
+  if (lenientOk) touchArgs(lenient);
+
+  picoosc::OSCMessageView strict;
+  strict.setStrict(true);
+  const bool strictOk = strict.parse(buffer, size);
+  if (strictOk) touchArgs(strict);
+
+  // Strict accepts a subset of what lenient accepts
+  if (strictOk && !lenientOk) __builtin_trap();
+  if (!isBundle && strictOk != (strictError == picoosc::OSCParseError::None)) __builtin_trap();
+
+  dispatcher(false).processPacket(buffer, size);
+  dispatcher(true).processPacket(buffer, size);
+  return 0;
+}
+
+#if !defined(PICOOSC_LIBFUZZER)
+namespace
+{
+bool runFile(const std::filesystem::path& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    std::fprintf(stderr, "cannot read %s\n", path.string().c_str());
+    return false;
+  }
+  const std::vector<char> bytes((std::istreambuf_iterator<char>(file)),
+                                std::istreambuf_iterator<char>());
+  LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+  return true;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <file or directory>...\n", argv[0]);
+    return 2;
+  }
+  std::size_t inputs = 0;
+  for (int i = 1; i < argc; i++) {
+    if (std::filesystem::is_directory(argv[i])) {
+      for (const auto& entry : std::filesystem::directory_iterator(argv[i])) {
+        if (entry.is_regular_file() && !runFile(entry.path())) return 1;
+        inputs += entry.is_regular_file() ? 1 : 0;
+      }
+    } else {
+      if (!runFile(argv[i])) return 1;
+      inputs++;
+    }
+  }
+  std::printf("%zu inputs ok\n", inputs);
+  return 0;
+}
+#endif
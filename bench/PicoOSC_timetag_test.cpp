@@ -0,0 +1,160 @@
+// Checks for the OSCTimetag conversions and the division-free helpers
+// behind them. The static_asserts pin down the constexpr results; the
+// runtime checks compare the same functions, called on values the
+// compiler cannot fold, against a 128-bit reference.
+//
+//   cmake --build build --target PicoOSC_timetag_test
+//   ctest --test-dir build
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "PicoOSC.hpp"
+
+using picoosc::OSCTimetag;
+
+// Rounding checks for the conversions
+static_assert(OSCTimetag::ntpFromMicros(0) == 0, "");
+static_assert(OSCTimetag::ntpFromMicros(1) == 4295, "4294.967 rounds up");
+static_assert(OSCTimetag::ntpFromMicros(1000000) == (1ull << 32), "");
+static_assert(OSCTimetag::ntpFromMicros(1999999) == (1ull << 32) + 4294963001u, "");
+static_assert(OSCTimetag::microsFromNtp(2147) == 0, "0.49989 us rounds down");
+static_assert(OSCTimetag::microsFromNtp(2148) == 1, "0.50012 us rounds up");
+static_assert(OSCTimetag::microsFromNtp(0xFFFFFFFFu) == 1000000, "carries into the next second");
+static_assert(OSCTimetag::microsFromNtp(OSCTimetag::ntpFromMicros(999999)) == 999999, "");
+static_assert(OSCTimetag::microsFromNtp(OSCTimetag::ntpFromMicros(0xFFFFFFFFull * 1000000 + 999999)) ==
+                  0xFFFFFFFFull * 1000000 + 999999,
+              "exact across the whole NTP era");
+static_assert(OSCTimetag::ntpFromNanos(1) == 4, "4.295 rounds down");
+static_assert(OSCTimetag::ntpFromNanos(1000000000) == (1ull << 32), "");
+static_assert(OSCTimetag::nanosFromNtp(OSCTimetag::ntpFromNanos(123456789)) == 123456789, "");
+static_assert(OSCTimetag::nanosFromNtp(OSCTimetag::ntpFromNanos(4000000000999999999ull)) == 4000000000999999999ull,
+              "");
+static_assert(OSCTimetag::fromUnixMicros(0).seconds == 2208988800u, "");
+static_assert(OSCTimetag::fromUnixMicros(1500000).fractions == 0x80000000u, "");
+static_assert(OSCTimetag{10, 0}.addMicros(-1) < OSCTimetag{10, 0}, "");
+static_assert(OSCTimetag{10, 0}.addMicros(-1).microsSince({10, 0}) == -1, "");
+static_assert(OSCTimetag{10, 0}.addMicros(2500000).microsSince({10, 0}) == 2500000, "");
+
+namespace
+{
+using u128 = unsigned __int128;
+
+constexpr uint64_t MAX_MICROS = 0xFFFFFFFFull * 1000000 + 999999;        // Last microsecond of the NTP era
+constexpr uint64_t MAX_NANOS = 0xFFFFFFFFull * 1000000000 + 999999999;  // Last nanosecond of the NTP era
+
+int failures = 0;
+
+void check(bool ok, const char* what, uint64_t input, uint64_t got, uint64_t want)
+{
+  if (ok) return;
+  if (++failures <= 20) {
+    std::printf("FAIL %s(%llu): got %llu, want %llu\n", what, static_cast<unsigned long long>(input),
+                static_cast<unsigned long long>(got), static_cast<unsigned long long>(want));
+  }
+}
+
+// xorshift64*, so every run checks the same values
+uint64_t nextRandom()
+{
+  static uint64_t state = 0x9E3779B97F4A7C15ull;
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return state * 0x2545F4914F6CDD1Dull;
+}
+
+// Round-half-up references, computed in 128 bits
+uint64_t refRound(u128 num, uint64_t den) { return static_cast<uint64_t>((num + den / 2) / den); }
+uint64_t refNtpFromMicros(uint64_t micros) { return refRound(static_cast<u128>(micros) << 32, 1000000); }
+uint64_t refNtpFromNanos(uint64_t nanos) { return refRound(static_cast<u128>(nanos) << 32, 1000000000); }
+uint64_t refMicrosFromNtp(uint64_t ntp) { return refRound(static_cast<u128>(ntp) * 1000000, 1ull << 32); }
+uint64_t refNanosFromNtp(uint64_t ntp) { return refRound(static_cast<u128>(ntp) * 1000000000, 1ull << 32); }
+uint64_t refMulHigh64(uint64_t a, uint64_t b) { return static_cast<uint64_t>((static_cast<u128>(a) * b) >> 64); }
+
+void checkMicros(uint64_t micros)
+{
+  const volatile uint64_t in = micros;
+  const uint64_t ntp = OSCTimetag::ntpFromMicros(in);
+  check(ntp == refNtpFromMicros(micros), "ntpFromMicros", micros, ntp, refNtpFromMicros(micros));
+  const uint64_t back = OSCTimetag::microsFromNtp(ntp);
+  check(back == micros, "microsFromNtp(ntpFromMicros)", micros, back, micros);
+}
+
+void checkNanos(uint64_t nanos)
+{
+  const volatile uint64_t in = nanos;
+  const uint64_t ntp = OSCTimetag::ntpFromNanos(in);
+  check(ntp == refNtpFromNanos(nanos), "ntpFromNanos", nanos, ntp, refNtpFromNanos(nanos));
+  const uint64_t back = OSCTimetag::nanosFromNtp(ntp);
+  check(back == nanos, "nanosFromNtp(ntpFromNanos)", nanos, back, nanos);
+}
+
+void checkNtp(uint64_t ntp)
+{
+  const volatile uint64_t in = ntp;
+  const uint64_t micros = OSCTimetag::microsFromNtp(in);
+  check(micros == refMicrosFromNtp(ntp), "microsFromNtp", ntp, micros, refMicrosFromNtp(ntp));
+  const uint64_t nanos = OSCTimetag::nanosFromNtp(in);
+  check(nanos == refNanosFromNtp(ntp), "nanosFromNtp", ntp, nanos, refNanosFromNtp(ntp));
+}
+
+void checkHelpers(uint64_t a, uint64_t b)
+{
+  const volatile uint64_t va = a;
+  const volatile uint64_t vb = b;
+  const uint64_t high = picoosc::mulHigh64(va, vb);
+  check(high == refMulHigh64(a, b), "mulHigh64", a, high, refMulHigh64(a, b));
+  const uint64_t q1 = picoosc::divide15625(va);
+  check(q1 == a / 15625, "divide15625", a, q1, a / 15625);
+  const uint64_t small = a >> 9;  // divide1953125 is exact below 2^55
+  const volatile uint64_t vsmall = small;
+  const uint64_t q2 = picoosc::divide1953125(vsmall);
+  check(q2 == small / 1953125, "divide1953125", small, q2, small / 1953125);
+}
+
+void checkOffsets(uint64_t raw, int64_t micros)
+{
+  const volatile uint64_t in = raw;
+  const volatile int64_t delta = micros;
+  const OSCTimetag base = OSCTimetag::fromRaw(in);
+  const OSCTimetag moved = base.addMicros(delta);
+  const int64_t since = moved.microsSince(base);
+  check(since == micros, "addMicros/microsSince", static_cast<uint64_t>(micros), static_cast<uint64_t>(since),
+        static_cast<uint64_t>(micros));
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const long iterations = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+  // Edges: around second boundaries, rounding midpoints and the end of the era
+  const uint64_t micros[] = {0, 1, 499999, 500000, 999999, 1000000, 1000001, MAX_MICROS};
+  const uint64_t nanos[] = {0, 1, 999999999, 1000000000, 1000000001, MAX_NANOS};
+  const uint64_t ntps[] = {0, 1, 2147, 2148, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, ~0ull};
+  const uint64_t dividends[] = {0, 1, 15624, 15625, (1ull << 55) - 1, ~0ull};
+  for (uint64_t x : micros) checkMicros(x);
+  for (uint64_t x : nanos) checkNanos(x);
+  for (uint64_t x : ntps) checkNtp(x);
+  for (uint64_t x : dividends) checkHelpers(x, ~0ull);
+
+  for (long i = 0; i < iterations; i++) {
+    const uint64_t r = nextRandom();
+    checkMicros(r % (MAX_MICROS + 1));
+    checkMicros(r % 1000000);  // Fraction-only values
+    checkNanos(r % (MAX_NANOS + 1));
+    checkNtp(r);
+    checkHelpers(r, nextRandom());
+    // Offsets of up to about 35 minutes either way
+    checkOffsets(nextRandom(), static_cast<int64_t>(nextRandom() % 4294967296ull) - 2147483648ll);
+  }
+
+  if (failures > 0) {
+    std::printf("%d failures\n", failures);
+    return 1;
+  }
+  std::printf("timetag conversions ok (%ld random inputs)\n", iterations);
+  return 0;
+}
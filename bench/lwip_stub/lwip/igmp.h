@@ -0,0 +1,6 @@
+#pragma once
+
+#include "lwip/ip_addr.h"
+
+err_t igmp_joingroup(const ip4_addr_t* ifaddr, const ip4_addr_t* groupaddr);
+err_t igmp_leavegroup(const ip4_addr_t* ifaddr, const ip4_addr_t* groupaddr);
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "lwip/err.h"
+#include "lwip/opt.h"
+
+// IPv4 only; addr is in network byte order like lwIP's ip4_addr_t
+typedef struct ip_addr
+{
+  uint32_t addr;
+} ip_addr_t;
+typedef ip_addr_t ip4_addr_t;
+
+extern const ip_addr_t ip_addr_any;
+extern const ip_addr_t ip_addr_broadcast;
+
+#define IP_ADDR_ANY (&ip_addr_any)
+#define IP4_ADDR_ANY4 (&ip_addr_any)
+#define IP_ADDR_BROADCAST (&ip_addr_broadcast)
+
+#define ip_2_ip4(ipaddr) (ipaddr)
+#define ip_addr_cmp(a, b) ((a)->addr == (b)->addr)
+#define ip_addr_set_zero(a) ((a)->addr = 0)
+#define ip_addr_isany(a) ((a) == NULL || (a)->addr == 0)
+#define ip_addr_ismulticast(a) (((a)->addr & 0xf0U) == 0xe0U)
+#define ip4_addr_get_u32(a) ((a)->addr)
+
+int ipaddr_aton(const char* cp, ip_addr_t* addr);
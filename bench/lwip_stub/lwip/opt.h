@@ -0,0 +1,21 @@
+#pragma once
+
+// Minimal host stand-in for the parts of lwIP used by PicoOSC.
+// Only intended for benchmarks and tools; see ../lwip_stub.cpp.
+
+#define LWIP_IGMP 1
+#define LWIP_TCP 1
+#define LWIP_MULTICAST_TX_OPTIONS 1
+#define LWIP_SUPPORT_CUSTOM_PBUF 1
+#define IP_SOF_BROADCAST 1
+#define TCP_SND_QUEUELEN 16
+
+#define MEM_ALIGNMENT 4
+#define LWIP_MEM_ALIGN_SIZE(size) (((size) + MEM_ALIGNMENT - 1U) & ~(MEM_ALIGNMENT - 1U))
+#define LWIP_MEM_ALIGN(addr) \
+  ((void*)(((uintptr_t)(addr) + MEM_ALIGNMENT - 1) & ~(uintptr_t)(MEM_ALIGNMENT - 1)))
+
+#define PBUF_LINK_ENCAPSULATION_HLEN 0
+#define PBUF_LINK_HLEN 14
+#define PBUF_IP_HLEN 20
+#define PBUF_TRANSPORT_HLEN 8
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "lwip/err.h"
+#include "lwip/opt.h"
+
+typedef enum
+{
+  PBUF_TRANSPORT,
+  PBUF_IP,
+  PBUF_LINK,
+  PBUF_RAW_TX,
+  PBUF_RAW
+} pbuf_layer;
+
+typedef enum
+{
+  PBUF_RAM,
+  PBUF_ROM,
+  PBUF_REF,
+  PBUF_POOL
+} pbuf_type;
+
+struct pbuf
+{
+  struct pbuf* next;
+  void* payload;
+  uint16_t tot_len;
+  uint16_t len;
+  uint8_t type_internal;
+  uint8_t flags;
+  uint16_t ref;
+  uint8_t if_idx;
+};
+
+typedef void (*pbuf_free_custom_fn)(struct pbuf* p);
+
+struct pbuf_custom
+{
+  struct pbuf pbuf;
+  pbuf_free_custom_fn custom_free_function;
+};
+
+struct pbuf* pbuf_alloc(pbuf_layer layer, uint16_t length, pbuf_type type);
+struct pbuf* pbuf_alloced_custom(pbuf_layer l,
+                                 uint16_t length,
+                                 pbuf_type type,
+                                 struct pbuf_custom* p,
+                                 void* payload_mem,
+                                 uint16_t payload_mem_len);
+uint8_t pbuf_free(struct pbuf* p);
+void pbuf_ref(struct pbuf* p);
+uint16_t pbuf_copy_partial(const struct pbuf* p, void* dataptr, uint16_t len, uint16_t offset);
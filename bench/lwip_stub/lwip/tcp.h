@@ -0,0 +1,38 @@
+#pragma once
+
+#include "lwip/ip_addr.h"
+#include "lwip/opt.h"
+#include "lwip/pbuf.h"
+
+// TCP is declared so PicoOSC compiles on the host, but the stub has no
+// stream implementation: tcp_new() always fails.
+
+struct tcp_pcb;
+
+typedef err_t (*tcp_accept_fn)(void* arg, struct tcp_pcb* newpcb, err_t err);
+typedef err_t (*tcp_recv_fn)(void* arg, struct tcp_pcb* tpcb, struct pbuf* p, err_t err);
+typedef err_t (*tcp_connected_fn)(void* arg, struct tcp_pcb* tpcb, err_t err);
+typedef void (*tcp_err_fn)(void* arg, err_t err);
+
+#define TCP_WRITE_FLAG_COPY 0x01
+#define TCP_WRITE_FLAG_MORE 0x02
+
+struct tcp_pcb* tcp_new(void);
+err_t tcp_bind(struct tcp_pcb* pcb, const ip_addr_t* ipaddr, uint16_t port);
+struct tcp_pcb* tcp_listen_with_backlog(struct tcp_pcb* pcb, uint8_t backlog);
+void tcp_accept(struct tcp_pcb* pcb, tcp_accept_fn accept);
+void tcp_arg(struct tcp_pcb* pcb, void* arg);
+void tcp_recv(struct tcp_pcb* pcb, tcp_recv_fn recv);
+void tcp_err(struct tcp_pcb* pcb, tcp_err_fn err);
+void tcp_recved(struct tcp_pcb* pcb, uint16_t len);
+err_t tcp_close(struct tcp_pcb* pcb);
+void tcp_abort(struct tcp_pcb* pcb);
+err_t tcp_write(struct tcp_pcb* pcb, const void* dataptr, uint16_t len, uint8_t apiflags);
+err_t tcp_output(struct tcp_pcb* pcb);
+uint16_t tcp_sndbuf(const struct tcp_pcb* pcb);
+uint16_t tcp_sndqueuelen(const struct tcp_pcb* pcb);
+err_t tcp_connect(struct tcp_pcb* pcb,
+                  const ip_addr_t* ipaddr,
+                  uint16_t port,
+                  tcp_connected_fn connected);
+void tcp_nagle_disable(struct tcp_pcb* pcb);
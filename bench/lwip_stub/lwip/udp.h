@@ -0,0 +1,42 @@
+#pragma once
+
+#include "lwip/ip_addr.h"
+#include "lwip/opt.h"
+#include "lwip/pbuf.h"
+
+#define SOF_BROADCAST 0x20U
+#define UDP_FLAGS_MULTICAST_LOOP 0x08U
+
+struct udp_pcb;
+
+typedef void (*udp_recv_fn)(
+    void* arg, struct udp_pcb* pcb, struct pbuf* p, const ip_addr_t* addr, uint16_t port);
+
+struct udp_pcb
+{
+  ip_addr_t local_ip;
+  uint16_t local_port;
+  uint8_t so_options;
+  uint8_t flags;
+  uint8_t mcast_ttl;
+  ip4_addr_t mcast_ip4;
+  udp_recv_fn recv;
+  void* recv_arg;
+  struct udp_pcb* next;
+};
+
+struct udp_pcb* udp_new(void);
+void udp_remove(struct udp_pcb* pcb);
+err_t udp_bind(struct udp_pcb* pcb, const ip_addr_t* ipaddr, uint16_t port);
+err_t udp_sendto(struct udp_pcb* pcb, struct pbuf* p, const ip_addr_t* dst_ip, uint16_t dst_port);
+void udp_recv(struct udp_pcb* pcb, udp_recv_fn recv, void* recv_arg);
+
+#define ip_set_option(pcb, opt) ((pcb)->so_options |= (opt))
+#define ip_reset_option(pcb, opt) ((pcb)->so_options &= (uint8_t) ~(opt))
+#define ip_get_option(pcb, opt) ((pcb)->so_options & (opt))
+#define udp_set_flags(pcb, set_flags) ((pcb)->flags |= (set_flags))
+#define udp_clear_flags(pcb, clr_flags) ((pcb)->flags &= (uint8_t) ~(clr_flags))
+#define udp_is_flag_set(pcb, flag) (((pcb)->flags & (flag)) != 0)
+#define udp_set_multicast_ttl(pcb, value) ((pcb)->mcast_ttl = (uint8_t)(value))
+#define udp_get_multicast_ttl(pcb) ((pcb)->mcast_ttl)
+#define udp_set_multicast_netif_addr(pcb, ip4addr) ((pcb)->mcast_ip4 = *(ip4addr))
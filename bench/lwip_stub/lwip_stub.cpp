@@ -0,0 +1,280 @@
+// Minimal host implementation of the lwIP raw API used by PicoOSC.
+//
+// UDP datagrams are delivered synchronously: udp_sendto() copies the
+// payload into a fresh pbuf (as a network interface would) and calls the
+// receive callback of every pcb bound to the destination port. This makes
+// the send -> receive -> parse -> dispatch path measurable without a
+// network. TCP is not implemented.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "lwip/igmp.h"
+#include "lwip/pbuf.h"
+#include "lwip/tcp.h"
+#include "lwip/udp.h"
+
+namespace
+{
+constexpr uint8_t pbufFlagCustom = 0x02;
+constexpr uint16_t transportHeaderSize =
+    PBUF_LINK_ENCAPSULATION_HLEN + PBUF_LINK_HLEN + PBUF_IP_HLEN + PBUF_TRANSPORT_HLEN;
+
+udp_pcb* udpPcbs = nullptr;
+
+uint16_t layerOffset(pbuf_layer layer)
+{
+  switch (layer) {
+    case PBUF_TRANSPORT:
+      return transportHeaderSize;
+    case PBUF_IP:
+      return PBUF_LINK_ENCAPSULATION_HLEN + PBUF_LINK_HLEN + PBUF_IP_HLEN;
+    case PBUF_LINK:
+      return PBUF_LINK_ENCAPSULATION_HLEN + PBUF_LINK_HLEN;
+    default:
+      return 0;
+  }
+}
+}  // namespace
+
+const ip_addr_t ip_addr_any = {0x00000000U};
+const ip_addr_t ip_addr_broadcast = {0xffffffffU};
+
+int ipaddr_aton(const char* cp, ip_addr_t* addr)
+{
+  unsigned parts[4];
+  char tail = 0;
+  if (std::sscanf(cp, "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &tail) != 4) {
+    return 0;
+  }
+  uint8_t bytes[4];
+  for (int i = 0; i < 4; i++) {
+    if (parts[i] > 255) {
+      return 0;
+    }
+    bytes[i] = static_cast<uint8_t>(parts[i]);
+  }
+  if (addr) {
+    std::memcpy(&addr->addr, bytes, 4);  // Network byte order
+  }
+  return 1;
+}
+
+struct pbuf* pbuf_alloc(pbuf_layer layer, uint16_t length, pbuf_type type)
+{
+  struct pbuf* p = nullptr;
+  if (type == PBUF_REF || type == PBUF_ROM) {
+    p = static_cast<struct pbuf*>(std::calloc(1, sizeof(struct pbuf)));
+    if (!p) {
+      return nullptr;
+    }
+  } else {
+    const uint16_t offset = layerOffset(layer);
+    const std::size_t headerSize = LWIP_MEM_ALIGN_SIZE(sizeof(struct pbuf));
+    p = static_cast<struct pbuf*>(std::calloc(1, headerSize + offset + length));
+    if (!p) {
+      return nullptr;
+    }
+    p->payload = reinterpret_cast<uint8_t*>(p) + headerSize + offset;
+  }
+  p->len = length;
+  p->tot_len = length;
+  p->type_internal = static_cast<uint8_t>(type);
+  p->ref = 1;
+  return p;
+}
+
+struct pbuf* pbuf_alloced_custom(pbuf_layer l,
+                                 uint16_t length,
+                                 pbuf_type type,
+                                 struct pbuf_custom* p,
+                                 void* payload_mem,
+                                 uint16_t payload_mem_len)
+{
+  const uint16_t offset = layerOffset(l);
+  if (LWIP_MEM_ALIGN_SIZE(offset) + length > payload_mem_len) {
+    return nullptr;
+  }
+  p->pbuf.next = nullptr;
+  p->pbuf.payload = payload_mem
+      ? LWIP_MEM_ALIGN(static_cast<uint8_t*>(payload_mem) + LWIP_MEM_ALIGN_SIZE(offset))
+      : nullptr;
+  p->pbuf.len = length;
+  p->pbuf.tot_len = length;
+  p->pbuf.type_internal = static_cast<uint8_t>(type);
+  p->pbuf.flags = pbufFlagCustom;
+  p->pbuf.ref = 1;
+  return &p->pbuf;
+}
+
+uint8_t pbuf_free(struct pbuf* p)
+{
+  uint8_t count = 0;
+  while (p) {
+    if (--p->ref > 0) {
+      break;
+    }
+    struct pbuf* next = p->next;
+    if (p->flags & pbufFlagCustom) {
+      reinterpret_cast<struct pbuf_custom*>(p)->custom_free_function(p);
+    } else {
+      std::free(p);
+    }
+    count++;
+    p = next;
+  }
+  return count;
+}
+
+void pbuf_ref(struct pbuf* p)
+{
+  if (p) {
+    p->ref++;
+  }
+}
+
+uint16_t pbuf_copy_partial(const struct pbuf* p, void* dataptr, uint16_t len, uint16_t offset)
+{
+  uint16_t copied = 0;
+  for (; p && copied < len; p = p->next) {
+    if (offset >= p->len) {
+      offset = static_cast<uint16_t>(offset - p->len);
+      continue;
+    }
+    uint16_t n = static_cast<uint16_t>(p->len - offset);
+    if (n > len - copied) {
+      n = static_cast<uint16_t>(len - copied);
+    }
+    std::memcpy(static_cast<uint8_t*>(dataptr) + copied, static_cast<const uint8_t*>(p->payload) + offset, n);
+    copied = static_cast<uint16_t>(copied + n);
+    offset = 0;
+  }
+  return copied;
+}
+
+struct udp_pcb* udp_new(void)
+{
+  auto* pcb = static_cast<udp_pcb*>(std::calloc(1, sizeof(udp_pcb)));
+  if (pcb) {
+    pcb->mcast_ttl = 1;
+    pcb->next = udpPcbs;
+    udpPcbs = pcb;
+  }
+  return pcb;
+}
+
+void udp_remove(struct udp_pcb* pcb)
+{
+  for (udp_pcb** it = &udpPcbs; *it; it = &(*it)->next) {
+    if (*it == pcb) {
+      *it = pcb->next;
+      break;
+    }
+  }
+  std::free(pcb);
+}
+
+err_t udp_bind(struct udp_pcb* pcb, const ip_addr_t* ipaddr, uint16_t port)
+{
+  for (udp_pcb* other = udpPcbs; other; other = other->next) {
+    if (other != pcb && other->local_port == port && port != 0) {
+      return ERR_USE;
+    }
+  }
+  pcb->local_ip = ipaddr ? *ipaddr : ip_addr_any;
+  pcb->local_port = port;
+  return ERR_OK;
+}
+
+err_t udp_sendto(struct udp_pcb* pcb, struct pbuf* p, const ip_addr_t* dst_ip, uint16_t dst_port)
+{
+  (void)dst_ip;
+  static const ip_addr_t loopback = {0x0100007fU};
+
+  for (udp_pcb* target = udpPcbs; target; target = target->next) {
+    if (target->local_port != dst_port || !target->recv) {
+      continue;
+    }
+    struct pbuf* q = pbuf_alloc(PBUF_RAW, p->tot_len, PBUF_RAM);
+    if (!q) {
+      return ERR_MEM;
+    }
+    pbuf_copy_partial(p, q->payload, p->tot_len, 0);
+    target->recv(target->recv_arg, target, q, &loopback, pcb->local_port);
+  }
+  return ERR_OK;
+}
+
+void udp_recv(struct udp_pcb* pcb, udp_recv_fn recv, void* recv_arg)
+{
+  pcb->recv = recv;
+  pcb->recv_arg = recv_arg;
+}
+
+err_t igmp_joingroup(const ip4_addr_t* ifaddr, const ip4_addr_t* groupaddr)
+{
+  (void)ifaddr;
+  (void)groupaddr;
+  return ERR_OK;
+}
+
+err_t igmp_leavegroup(const ip4_addr_t* ifaddr, const ip4_addr_t* groupaddr)
+{
+  (void)ifaddr;
+  (void)groupaddr;
+  return ERR_OK;
+}
+
+struct tcp_pcb* tcp_new(void)
+{
+  return nullptr;
+}
+
+err_t tcp_bind(struct tcp_pcb*, const ip_addr_t*, uint16_t)
+{
+  return ERR_VAL;
+}
+
+struct tcp_pcb* tcp_listen_with_backlog(struct tcp_pcb*, uint8_t)
+{
+  return nullptr;
+}
+
+void tcp_accept(struct tcp_pcb*, tcp_accept_fn) {}
+void tcp_arg(struct tcp_pcb*, void*) {}
+void tcp_recv(struct tcp_pcb*, tcp_recv_fn) {}
+void tcp_err(struct tcp_pcb*, tcp_err_fn) {}
+void tcp_recved(struct tcp_pcb*, uint16_t) {}
+void tcp_abort(struct tcp_pcb*) {}
+void tcp_nagle_disable(struct tcp_pcb*) {}
+
+err_t tcp_close(struct tcp_pcb*)
+{
+  return ERR_OK;
+}
+
+err_t tcp_write(struct tcp_pcb*, const void*, uint16_t, uint8_t)
+{
+  return ERR_CONN;
+}
+
+err_t tcp_output(struct tcp_pcb*)
+{
+  return ERR_CONN;
+}
+
+uint16_t tcp_sndbuf(const struct tcp_pcb*)
+{
+  return 0;
+}
+
+uint16_t tcp_sndqueuelen(const struct tcp_pcb*)
+{
+  return 0;
+}
+
+err_t tcp_connect(struct tcp_pcb*, const ip_addr_t*, uint16_t, tcp_connected_fn)
+{
+  return ERR_CONN;
+}
@@ -1,13 +1,24 @@
 #include <climits>
 #include <cstdint>
 #include <cstring>
-#include <iostream>
+#include <type_traits>
 
 #include "lwip/pbuf.h"
 #include "lwip/udp.h"
 
+#include "PicoOSCLog.hpp"
+
 namespace picoosc
 {
+// The result of every operation that can fail
+enum class OSCError
+{
+  Ok = 0,
+  BufferFull,
+  AddressTooLong,
+  AllocFailed,
+  SendFailed,
+};
 // The maximum size of an OSC message is 1024 bytes.
 static constexpr auto MAX_MESSAGE_SIZE = 1024;
 
@@ -92,11 +103,16 @@ public:
   }
 
   // Send packet
-  auto send(const char* buffer, uint16_t size)
+  auto send(const char* buffer, uint16_t size) -> OSCError
   {
     // Create a pbuf
     struct pbuf* p = pbuf_alloc(PBUF_TRANSPORT, size, PBUF_RAM);
 
+    if (p == nullptr) {
+      PICOOSC_LOG_ERROR("Failed to allocate pbuf for %u bytes\n", size);
+      return OSCError::AllocFailed;
+    }
+
     // Copy the buffer to the pbuf
     std::memcpy(p->payload, buffer, size);
 
@@ -107,12 +123,12 @@ public:
     pbuf_free(p);
 
     if (error != ERR_OK) {
-      printf("Failed to send UDP packet! error=%d\n", error);
-      return 1;
-    } else {
-      printf("Sent packet \n");
-      return 0;
-    };
+      PICOOSC_LOG_ERROR("Failed to send UDP packet! error=%d\n", error);
+      return OSCError::SendFailed;
+    }
+
+    PICOOSC_LOG_INFO("Sent packet\n");
+    return OSCError::Ok;
   }
 
 private:
@@ -146,11 +162,18 @@ public:
   // }
 
   // Add an OSC address to the message
-  void addAddress(const char* address)
+  auto addAddress(const char* address) -> OSCError
   {
     // Check if the address is too long
     if (strlen(address) > MAX_ADDRESS_SIZE) {
-      return;
+      PICOOSC_LOG_WARN("OSC address too long\n");
+      return OSCError::AddressTooLong;
+    }
+
+    // Check if there is enough space in the buffer (address, null, padding)
+    if (mBufferSize + strlen(address) + 4 > MAX_MESSAGE_SIZE) {
+      PICOOSC_LOG_WARN("Not enough space in buffer\n");
+      return OSCError::BufferFull;
     }
 
     // Add the address to the buffer
@@ -163,6 +186,8 @@ public:
 
     // Pad the buffer to the next 4-byte boundary
     padBuffer();
+
+    return OSCError::Ok;
   }
 
   void padBuffer()
@@ -177,18 +202,26 @@ public:
   // Use templates and constexpr if to add the correct type tag to the buffer
   // and then add the value to the buffer
   template<typename T>
-  void add(T value)
+  auto add(T value) -> OSCError
   {
-    // Check if there is enough space in the buffer
-    if (mBufferSize + 4 > MAX_MESSAGE_SIZE) {
-      printf("Not enough space in buffer\n");
-      return;
-    }
-
     constexpr auto isFloat = std::is_same<T, float>::value;
     constexpr auto isInt = std::is_same<T, int32_t>::value;
     constexpr auto isString = std::is_same<T, const char*>::value;
 
+    static_assert(isFloat || isInt || isString,
+                  "Unsupported type: use float, int32_t or const char*");
+
+    // Check if there is enough space in the buffer: type tag (padded to 4)
+    // plus the value (a string needs its length plus null and padding)
+    std::size_t needed = 4 + 4;
+    if constexpr (isString) {
+      needed = 4 + 2 * (std::strlen(value) + 4);
+    }
+    if (mBufferSize + needed > MAX_MESSAGE_SIZE) {
+      PICOOSC_LOG_WARN("Not enough space in buffer\n");
+      return OSCError::BufferFull;
+    }
+
     // Add type tag
     // Add comma before type tag
     mBuffer[mBufferSize] = ',';
@@ -200,8 +233,6 @@ public:
       mBuffer[mBufferSize] = 'i';
     } else if constexpr (isString) {
       mBuffer[mBufferSize] = 's';
-    } else {
-      printf("Unsupported type\n");
     }
 
     mBufferSize += 1;
@@ -239,13 +270,11 @@ public:
       // Copy the string to the buffer
       std::memcpy(mBuffer + mBufferSize, value, std::strlen(value));
       mBufferSize += std::strlen(value);
-
-    } else {
-      printf("Unsupported type\n");
-      return;
     }
 
     padBuffer();
+
+    return OSCError::Ok;
   }
 
   // Get the data
@@ -268,20 +297,19 @@ public:
   }
 
   // Send the message over the network using a OSC Client
-  auto send(OSCClient& client) -> bool
+  auto send(OSCClient& client) -> OSCError
   {
-    const auto error = client.send(mBuffer, mBufferSize);
-
-    return error == ERR_OK;
+    return client.send(mBuffer, mBufferSize);
   }
 
-  // Print the buffer
-  void print()
+  // Print the buffer through PICOOSC_LOG_HANDLER (printf by default),
+  // whatever PICOOSC_LOG_LEVEL is
+  void print() const
   {
     for (std::size_t i = 0; i < mBufferSize; i++) {
-      std::cout << mBuffer[i];
+      PICOOSC_LOG_HANDLER(3, "%c", mBuffer[i]);
     }
-    std::cout << std::endl;
+    PICOOSC_LOG_HANDLER(3, "\n");
   }
 
   // Decode a udp packet buffer
@@ -0,0 +1,43 @@
+#pragma once
+
+// Logging hooks for PicoOSC.hpp
+//
+// Logging is compiled out unless PICOOSC_LOG_LEVEL is defined before the
+// first PicoOSC header is included:
+//   0 = off (default), 1 = errors, 2 = warnings, 3 = info
+//
+// Messages go to PICOOSC_LOG_HANDLER(level, format, ...), which defaults to
+// printf. Define it to route them elsewhere, e.g.
+//   #define PICOOSC_LOG_HANDLER(level, ...) my_log(level, __VA_ARGS__)
+// Explicit output such as OSCMessage::print() always goes to the handler,
+// whatever the level. The single-file header in PicoOSC-fork/ defines the
+// same macros behind the same guards, so a definition made before either
+// header is included is never overridden.
+#ifndef PICOOSC_LOG_LEVEL
+#  define PICOOSC_LOG_LEVEL 0
+#endif
+
+#ifndef PICOOSC_LOG_HANDLER
+#  include <cstdio>
+#  define PICOOSC_LOG_HANDLER(level, ...) std::printf(__VA_ARGS__)
+#endif
+
+#ifndef PICOOSC_LOG_ERROR
+#  if PICOOSC_LOG_LEVEL >= 1
+#    define PICOOSC_LOG_ERROR(...) PICOOSC_LOG_HANDLER(1, __VA_ARGS__)
+#  else
+#    define PICOOSC_LOG_ERROR(...) ((void)0)
+#  endif
+
+#  if PICOOSC_LOG_LEVEL >= 2
+#    define PICOOSC_LOG_WARN(...) PICOOSC_LOG_HANDLER(2, __VA_ARGS__)
+#  else
+#    define PICOOSC_LOG_WARN(...) ((void)0)
+#  endif
+
+#  if PICOOSC_LOG_LEVEL >= 3
+#    define PICOOSC_LOG_INFO(...) PICOOSC_LOG_HANDLER(3, __VA_ARGS__)
+#  else
+#    define PICOOSC_LOG_INFO(...) ((void)0)
+#  endif
+#endif